@@ -0,0 +1,1248 @@
+/* Benchmarks for ilist.h and the alternative representations.
+
+    Build with `make bench` (links with -Wl,--wrap so that every heap
+    allocation is counted) and run:
+
+        ./bench [--json] [--min N] [--max N] [--filter SUBSTRING]
+
+    Each operation is timed at sizes 1e3 .. 1e7 (limited by --min/--max).
+    Bulk operations report time per element, point operations (indexed access,
+    pops at the back) report time per call. A benchmark that does not free
+    everything it allocated aborts the run. */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <time.h>
+#include <malloc.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <sys/resource.h>
+#include "ilist.h"
+#include "ilist_macros.h"
+#include "ulist.h"
+#include "clist.h"
+#include "ifile.h"
+#include "ivector.h"
+#include "dlist.h"
+#include "ireduce.h"
+#include "cqueue.h"
+#include "plist.h"
+#include "istream.h"
+#include "istats.h"
+#include "tlist.h"
+
+/* Allocation counting (see -Wl,--wrap in the Makefile) */
+
+void* __real_malloc(size_t);
+void* __real_calloc(size_t, size_t);
+void* __real_realloc(void*, size_t);
+void __real_free(void*);
+
+/* Atomic because the queue benchmarks allocate on several threads. */
+static atomic_long allocs;
+static atomic_long frees;
+static atomic_long live_bytes;
+static atomic_long peak_bytes;
+
+static void track(void *ptr, long sign) {
+    if (ptr) {
+        long bytes = sign * (long) malloc_usable_size(ptr);
+        long live = atomic_fetch_add_explicit(&live_bytes, bytes, memory_order_relaxed) + bytes;
+        long peak = atomic_load_explicit(&peak_bytes, memory_order_relaxed);
+        while (live > peak && !atomic_compare_exchange_weak_explicit(&peak_bytes, &peak, live,
+                memory_order_relaxed, memory_order_relaxed));
+    }
+}
+
+void* __wrap_malloc(size_t size) {
+    void *ptr = __real_malloc(size);
+    allocs++;
+    track(ptr, 1);
+    return ptr;
+}
+
+void* __wrap_calloc(size_t count, size_t size) {
+    void *ptr = __real_calloc(count, size);
+    allocs++;
+    track(ptr, 1);
+    return ptr;
+}
+
+void* __wrap_realloc(void *old, size_t size) {
+    track(old, -1);
+    void *ptr = __real_realloc(old, size);
+    allocs++;
+    track(ptr ? ptr : old, 1);
+    return ptr;
+}
+
+void __wrap_free(void *ptr) {
+    if (ptr) {
+        frees++;
+        track(ptr, -1);
+    }
+    __real_free(ptr);
+}
+
+/* Fixtures */
+
+typedef enum {
+    SETUP_NONE,
+    SETUP_LIST,
+    SETUP_EXPORT,
+    SETUP_INDEXED,
+    SETUP_TRACKED,
+    SETUP_ARRAY,
+    SETUP_DUPLICATES,
+    SETUP_PATTERN,
+    SETUP_SETS,
+    SETUP_ULIST,
+    SETUP_CLIST,
+    SETUP_FILE,
+    SETUP_IVECTOR,
+    SETUP_DLIST,
+    SETUP_PLIST,
+    SETUP_TLIST
+} Setup;
+
+typedef struct {
+    int n;
+    int calls;
+    int *arr;
+    IList *list;
+    IList *other;
+    IList *result;
+    UList *ulist;
+    CList *clist;
+    IVector *ivector;
+    DList *dlist;
+    PList *plist;
+    i64list *i64list;
+    f64list *f64list;
+} Fixture;
+
+typedef struct {
+    const char *group;
+    const char *name;
+    Setup setup;
+    int per_call;
+    void (*run)(Fixture*);
+} Bench;
+
+static volatile long sink;
+
+static int inc(int x) { return x + 1; }
+static int is_even(int x) { return x % 2 == 0; }
+static int is_multiple(int x, void *ctx) { return x % *(int*) ctx == 0; }
+static int is_negative(int x) { return x < 0; }
+static int is_non_negative(int x) { return x >= 0; }
+static int is_below(int x, void *ctx) { return x < *(int*) ctx; }
+static int add(int a, int b) { return a + b; }
+static void consume(int x) { sink += x; }
+
+/* Number of calls for operations that cost O(n) per call. */
+static int point_calls(int n) {
+    int calls = 20000000 / n;
+    if (calls < 10) {
+        calls = 10;
+    }
+    return calls < n ? calls : n;
+}
+
+static int* index_array(int n) {
+    int *arr = (int*) malloc(n * sizeof(int));
+    for (int i = 0; i < n; i++) {
+        arr[i] = i;
+    }
+    return arr;
+}
+
+/* Scratch file for the persistence benchmarks. */
+#define BENCH_FILE "bench_list.bin"
+
+static void setup(Fixture *f, Setup kind, int n) {
+    memset(f, 0, sizeof(Fixture));
+    f->n = n;
+    f->calls = point_calls(n);
+    switch (kind) {
+    case SETUP_NONE:
+        break;
+    case SETUP_LIST:
+        f->list = range_ex(0, n);
+        break;
+    case SETUP_EXPORT:
+        /* the array is the destination buffer */
+        f->list = range_ex(0, n);
+        f->arr = index_array(n);
+        break;
+    case SETUP_INDEXED:
+        f->list = attach_index(range_ex(0, n));
+        break;
+    case SETUP_TRACKED:
+        f->list = attach_aggregates(range_ex(0, n));
+        break;
+    case SETUP_ARRAY:
+        f->arr = index_array(n);
+        break;
+    case SETUP_DUPLICATES:
+        f->list = empty_list();
+        for (int i = 0; i < n; i++) {
+            push_back(f->list, (int) ((i * 2654435761u) % (unsigned) (n / 10 + 1)));
+        }
+        break;
+    case SETUP_PATTERN:
+        /* a repetitive text with the only full match at the end */
+        f->list = repeat(0, n);
+        update(f->list, n - 1, 1);
+        f->other = repeat(0, n / 100 + 1);
+        update(f->other, f->other->size - 1, 1);
+        break;
+    case SETUP_SETS:
+        /* multiples of 2 and of 3 below 3n/2, about n elements together */
+        f->list = range_step_ex(0, n / 2 * 3, 2);
+        f->other = range_step_ex(0, n / 2 * 3, 3);
+        break;
+    case SETUP_ULIST:
+        f->arr = index_array(n);
+        f->ulist = ulist_from_array(n, f->arr);
+        break;
+    case SETUP_CLIST:
+        f->arr = index_array(n);
+        f->clist = clist_from_array(n, f->arr);
+        break;
+    case SETUP_FILE:
+        f->list = range_ex(0, n);
+        save_list(f->list, BENCH_FILE);
+        break;
+    case SETUP_IVECTOR:
+        f->arr = index_array(n);
+        f->ivector = ivector_from_array(n, f->arr);
+        break;
+    case SETUP_DLIST:
+        f->arr = index_array(n);
+        f->dlist = dlist_from_array(n, f->arr);
+        break;
+    case SETUP_PLIST:
+        f->arr = index_array(n);
+        f->plist = plist_from_array(n, f->arr);
+        break;
+    case SETUP_TLIST: {
+        /* the values 0 .. n-1, as in the other fixtures */
+        int64_t *longs = (int64_t*) malloc(n * sizeof(int64_t));
+        double *doubles = (double*) malloc(n * sizeof(double));
+        for (int i = 0; i < n; i++) {
+            longs[i] = i;
+            doubles[i] = i;
+        }
+        f->i64list = i64list_from_array(n, longs);
+        f->f64list = f64list_from_array(n, doubles);
+        free(longs);
+        free(doubles);
+        break;
+    }
+    }
+}
+
+static void teardown(Fixture *f) {
+    remove(BENCH_FILE);
+    free(f->arr);
+    if (f->list) {
+        delete_list(&f->list);
+    }
+    if (f->other) {
+        delete_list(&f->other);
+    }
+    if (f->result) {
+        delete_list(&f->result);
+    }
+    if (f->ulist) {
+        ulist_delete_list(&f->ulist);
+    }
+    if (f->clist) {
+        clist_delete_list(&f->clist);
+    }
+    if (f->ivector) {
+        ivector_delete_list(&f->ivector);
+    }
+    if (f->dlist) {
+        dlist_delete_list(&f->dlist);
+    }
+    plist_release(&f->plist);
+    if (f->i64list) {
+        i64list_delete_list(&f->i64list);
+    }
+    if (f->f64list) {
+        f64list_delete_list(&f->f64list);
+    }
+}
+
+/* IList */
+
+static void b_range(Fixture *f) { f->result = range_ex(0, f->n); }
+static void b_from_array(Fixture *f) { f->result = from_array(f->n, f->arr); }
+static void b_repeat(Fixture *f) { f->result = repeat(7, f->n); }
+static void b_generate_n(Fixture *f) { f->result = generate_n(0, inc, f->n); }
+static void b_clone(Fixture *f) { f->result = clone(f->list); }
+static void b_to_array(Fixture *f) { free(to_array(f->list)); }
+static void b_to_array_into(Fixture *f) { sink += to_array_into(f->list, f->arr, f->n); }
+static void b_append_array(Fixture *f) { f->result = append_array(empty_list(), f->n, f->arr); }
+
+static void b_blocks_sum(Fixture *f) {
+    int buf[256];
+    int *values;
+    int n;
+    IListBlocks blocks = list_blocks(f->list, buf, 256);
+    while ((n = list_next_block(&blocks, &values)) > 0) {
+        sink += sum_array(n, values);
+    }
+}
+static void b_delete_list(Fixture *f) {
+    delete_list(&f->list);
+    f->list = NULL;
+}
+
+static void b_push(Fixture *f) {
+    f->result = empty_list();
+    for (int i = 0; i < f->n; i++) {
+        push(f->result, i);
+    }
+}
+
+static void b_push_back(Fixture *f) {
+    f->result = empty_list();
+    for (int i = 0; i < f->n; i++) {
+        push_back(f->result, i);
+    }
+}
+
+static void b_push_back_tracked(Fixture *f) {
+    f->result = attach_aggregates(empty_list());
+    for (int i = 0; i < f->n; i++) {
+        push_back(f->result, i);
+    }
+}
+
+static void b_pop(Fixture *f) {
+    for (int i = 0; i < f->n; i++) {
+        sink += pop(f->list);
+    }
+}
+
+static void b_pop_back(Fixture *f) {
+    for (int i = 0; i < f->calls; i++) {
+        sink += pop_back(f->list);
+    }
+}
+
+static void b_get(Fixture *f) {
+    unsigned x = 1;
+    for (int i = 0; i < f->calls; i++) {
+        x = x * 1103515245u + 12345u;
+        sink += get(f->list, (int) (x % (unsigned) f->n));
+    }
+}
+
+static void b_update(Fixture *f) {
+    unsigned x = 1;
+    for (int i = 0; i < f->calls; i++) {
+        x = x * 1103515245u + 12345u;
+        update(f->list, (int) (x % (unsigned) f->n), i);
+    }
+}
+
+static void b_insert(Fixture *f) {
+    unsigned x = 1;
+    for (int i = 0; i < f->calls; i++) {
+        x = x * 1103515245u + 12345u;
+        insert(f->list, (int) (x % (unsigned) f->list->size), i);
+    }
+}
+
+static void b_delete(Fixture *f) {
+    unsigned x = 1;
+    for (int i = 0; i < f->calls && f->list->size > 1; i++) {
+        x = x * 1103515245u + 12345u;
+        delete(f->list, (int) (x % (unsigned) f->list->size));
+    }
+}
+
+static void b_swap(Fixture *f) {
+    unsigned x = 1;
+    for (int i = 0; i < f->calls; i++) {
+        x = x * 1103515245u + 12345u;
+        int a = (int) (x % (unsigned) f->n);
+        x = x * 1103515245u + 12345u;
+        swap(f->list, a, (int) (x % (unsigned) f->n));
+    }
+}
+
+/* Random positional operations on an indexed list, repeated on a plain copy; every
+    read and the final contents of the two must agree. */
+static void b_mixed_indexed(Fixture *f) {
+    IList *plain = f->other = range_ex(0, f->n);
+    unsigned x = 1;
+    for (int i = 0; i < f->calls; i++) {
+        x = x * 1103515245u + 12345u;
+        int op = (int) (x >> 16) % 8;
+        x = x * 1103515245u + 12345u;
+        int a = (int) (x % (unsigned) f->list->size);
+        x = x * 1103515245u + 12345u;
+        int b = (int) (x % (unsigned) f->list->size);
+        if (op == 0) {
+            insert(f->list, a, i);
+            insert(plain, a, i);
+        } else if (op == 1 && f->list->size > 1) {
+            delete(f->list, a);
+            delete(plain, a);
+        } else if (op == 2) {
+            update(f->list, a, -i);
+            update(plain, a, -i);
+        } else if (op == 3) {
+            swap(f->list, a, b);
+            swap(plain, a, b);
+        } else if (op == 4 && f->list->size > 1) {
+            drop_back(f->list);
+            drop_back(plain);
+        } else if (op == 5 && f->list->size > 1 && pop_back(f->list) != pop_back(plain)) {
+            fprintf(stderr, "ilist.mixed_indexed: pop_back differs at call %d\n", i);
+            abort();
+        }
+        if (get(f->list, a % f->list->size) != get(plain, a % plain->size)
+                || get(f->list, b % f->list->size) != get(plain, b % plain->size)) {
+            fprintf(stderr, "ilist.mixed_indexed: get differs at call %d\n", i);
+            abort();
+        }
+    }
+    if (!equals(f->list, plain)) {
+        fprintf(stderr, "ilist.mixed_indexed: lists differ\n");
+        abort();
+    }
+}
+
+static void b_map(Fixture *f) { map(f->list, inc); }
+static void b_filter(Fixture *f) { f->result = filter(f->list, is_even); }
+static void b_foreach(Fixture *f) { foreach(f->list, consume); }
+static void b_fold_left(Fixture *f) { sink += fold_left(0, f->list, add); }
+static void b_fold_right(Fixture *f) { sink += fold_right(0, f->list, add); }
+static void b_reduce_right(Fixture *f) { sink += reduce_right(f->list, add); }
+static void b_count(Fixture *f) { sink += count(f->list, is_even); }
+
+static void b_count_ctx(Fixture *f) {
+    int divisor = 2;
+    sink += count_ctx(f->list, is_multiple, &divisor);
+}
+
+static void b_count_macro(Fixture *f) {
+    int divisor = 2, n;
+    LIST_COUNT(n, f->list, x, x % divisor == 0);
+    sink += n;
+}
+static void b_forall(Fixture *f) { sink += forall(f->list, is_non_negative); }
+static void b_exists(Fixture *f) { sink += exists(f->list, is_negative); }
+static void b_sum(Fixture *f) { sink += sum(f->list); }
+static void b_sum64(Fixture *f) { sink += sum64(f->list); }
+static void b_max(Fixture *f) { sink += max(f->list); }
+static void b_min(Fixture *f) { sink += min(f->list); }
+static void b_contains(Fixture *f) { sink += contains(f->list, -1); }
+
+/* Queries on a list with tracked aggregates; each call pushes a value first,
+    so the aggregates are kept up to date rather than only cached. */
+static void b_sum_tracked(Fixture *f) {
+    for (int i = 0; i < f->calls; i++) {
+        push_back(f->list, i);
+        sink += sum(f->list);
+    }
+}
+
+static void b_max_tracked(Fixture *f) {
+    for (int i = 0; i < f->calls; i++) {
+        push_back(f->list, i);
+        sink += max(f->list);
+    }
+}
+
+static void b_min_tracked(Fixture *f) {
+    for (int i = 0; i < f->calls; i++) {
+        push_back(f->list, i);
+        sink += min(f->list);
+    }
+}
+
+static void b_contains_tracked(Fixture *f) {
+    for (int i = 0; i < f->calls; i++) {
+        push_back(f->list, i);
+        sink += contains(f->list, -1);
+    }
+}
+
+/* Aborts unless the tracked aggregates of the list match a fresh pass over its nodes. */
+static void check_aggregates(IList *list, int call) {
+    long long total = 0;
+    int lo = INT_MAX, hi = INT_MIN, sorted = 1;
+    for (Node *cur = list->first; cur; cur = cur->next) {
+        total += cur->value;
+        lo = cur->value < lo ? cur->value : lo;
+        hi = cur->value > hi ? cur->value : hi;
+        sorted = sorted && (!cur->next || cur->value <= cur->next->value);
+    }
+    if (sum64(list) != total || sum(list) != (int) total || is_sorted(list) != sorted
+            || (is_not_empty(list) && (min(list) != lo || max(list) != hi))) {
+        fprintf(stderr, "ilist.mixed_tracked: aggregates differ at call %d\n", call);
+        abort();
+    }
+}
+
+/* Random mutations of a list with tracked aggregates, each checked against a
+    recomputation. The list is refilled when it runs low. */
+static void b_mixed_tracked(Fixture *f) {
+    unsigned x = 1;
+    int limit = f->n / 2 - 8;
+    for (int i = 0; i < f->calls; i++) {
+        x = x * 1103515245u + 12345u;
+        int op = (int) (x >> 16) % 12;
+        x = x * 1103515245u + 12345u;
+        int value = (int) (x % (unsigned) f->n) - f->n / 2;
+        int pos = (int) (x % (unsigned) f->list->size);
+        if (f->list->size < 4) {
+            int values[] = { value, -value, value / 2, f->n };
+            append_array(f->list, 4, values);
+        } else if (op == 0) {
+            sink += pop_back(f->list);
+        } else if (op == 1) {
+            drop_back(f->list);
+        } else if (op == 2) {
+            delete(f->list, pos);
+        } else if (op == 3) {
+            update(f->list, pos, value);
+        } else if (op == 4) {
+            insert(f->list, pos, value);
+        } else if (op == 5) {
+            sort(f->list);
+        } else if (op == 6) {
+            retain_if_ctx(f->list, is_below, &limit);
+        } else if (op == 7) {
+            dedup_adjacent(f->list);
+        } else if (op == 8) {
+            IList *rest = split_at(f->list, pos);
+            check_aggregates(f->list, i);
+            concat_move(f->list, rest);
+            delete_list(&rest);
+        } else if (op == 9) {
+            int values[] = { value, value + 1, value - 1 };
+            append_array(f->list, 3, values);
+        } else {
+            push_back(f->list, value);
+        }
+        check_aggregates(f->list, i);
+    }
+}
+
+static void b_index_of(Fixture *f) { sink += index_of(f->list, -1); }
+static void b_reverse(Fixture *f) { f->result = reverse(f->list); }
+static void b_take(Fixture *f) { f->result = take(f->list, f->n / 2); }
+static void b_take_right_while(Fixture *f) { f->result = take_right_while(f->list, is_non_negative); }
+static void b_slice(Fixture *f) { f->result = slice(f->list, f->n / 4, f->n / 4 * 3); }
+static void b_intersperse(Fixture *f) { f->result = intersperse(f->list, 0); }
+static void b_drop_back_n(Fixture *f) { drop_back_n(f->list, f->calls); }
+static void b_unique(Fixture *f) { f->result = unique(f->list); }
+static void b_distinct(Fixture *f) { distinct(f->list); }
+static void b_remove_if(Fixture *f) { remove_if(f->list, is_even); }
+static void b_partition(Fixture *f) { f->result = partition(f->list, is_even); }
+static void b_dedup_adjacent(Fixture *f) { dedup_adjacent(f->list); }
+static void b_map_into(Fixture *f) { map_into(f->list, inc, f->other); }
+static void b_delete_item(Fixture *f) { delete_item(f->list, 0); }
+static void b_is_suffix(Fixture *f) { sink += is_suffix(f->list, f->list); }
+static void b_is_sublist(Fixture *f) { sink += is_sublist(f->list, f->other); }
+static void b_add_all(Fixture *f) { add_all(f->list, f->other); }
+static void b_concat_move(Fixture *f) { concat_move(f->list, f->other); }
+static void b_split_at(Fixture *f) { f->result = split_at(f->list, f->n / 2); }
+static void b_union_sorted(Fixture *f) { f->result = union_sorted(f->list, f->other); }
+static void b_intersect_sorted(Fixture *f) { f->result = intersect_sorted(f->list, f->other); }
+static void b_union_sorted_move(Fixture *f) { union_sorted_move(f->list, f->other); }
+static void b_intersect_unsorted(Fixture *f) { f->result = intersect_unsorted(f->list, f->other); }
+
+typedef IList* (*SetOp)(IList*, IList*);
+
+/* Aborts unless the sorted, moving and unsorted forms of a set operation agree on
+    the lists; the unsorted result is sorted before the comparison. Returns the size. */
+static int check_set_op(IList *list, IList *other, SetOp sorted_op, SetOp move_op,
+        SetOp unsorted_op, const char *name) {
+    IList *expected = sorted_op(list, other);
+    IList *moved = clone(list);
+    IList *rest = clone(other);
+    move_op(moved, rest);
+    IList *unsorted = sort(unsorted_op(list, other));
+    if (!equals(expected, moved) || !equals(expected, unsorted) || is_not_empty(rest)) {
+        fprintf(stderr, "ilist.set_ops: %s forms differ\n", name);
+        abort();
+    }
+    int size = expected->size;
+    delete_list(&expected);
+    delete_list(&moved);
+    delete_list(&rest);
+    delete_list(&unsorted);
+    return size;
+}
+
+static void b_set_ops(Fixture *f) {
+    int both = check_set_op(f->list, f->other, intersect_sorted, intersect_sorted_move,
+            intersect_unsorted, "intersect");
+    int either = check_set_op(f->list, f->other, union_sorted, union_sorted_move,
+            union_unsorted, "union");
+    int only = check_set_op(f->list, f->other, difference_sorted, difference_sorted_move,
+            difference_unsorted, "difference");
+    int one = check_set_op(f->list, f->other, symmetric_difference_sorted,
+            symmetric_difference_sorted_move, symmetric_difference_unsorted, "symmetric_difference");
+    if (either != f->list->size + f->other->size - both || only != f->list->size - both
+            || one != either - both) {
+        fprintf(stderr, "ilist.set_ops: sizes do not add up\n");
+        abort();
+    }
+}
+static int compare_ints(const void *a, const void *b) {
+    int x = *(const int*) a;
+    int y = *(const int*) b;
+    return (x > y) - (x < y);
+}
+
+static int compare(int x, int y) { return (x > y) - (x < y); }
+
+/* Puts the extremes of int at the wrong ends of the list and returns its sum, which
+    the sort must keep. */
+static long long add_extremes(IList *list) {
+    push(list, INT_MAX);
+    push_back(list, INT_MIN);
+    return sum64(list);
+}
+
+static void check_sorted(IList *list, long long total, const char *name) {
+    if (!is_sorted(list) || sum64(list) != total || get_first(list) != INT_MIN || get_last(list) != INT_MAX) {
+        fprintf(stderr, "ilist.%s: list not sorted or elements changed\n", name);
+        abort();
+    }
+}
+
+static void b_sort(Fixture *f) {
+    long long total = add_extremes(f->list);
+    sort(f->list);
+    check_sorted(f->list, total, "sort");
+}
+
+static void b_sort_by(Fixture *f) {
+    long long total = add_extremes(f->list);
+    sort_by(f->list, compare);
+    check_sorted(f->list, total, "sort_by");
+}
+
+static void b_radix_sort(Fixture *f) {
+    long long total = add_extremes(f->list);
+    radix_sort(f->list);
+    check_sorted(f->list, total, "radix_sort");
+}
+
+/* The array round trip that sort replaces. */
+static void b_qsort_copy(Fixture *f) {
+    int *arr = to_array(f->list);
+    qsort(arr, f->n, sizeof(int), compare_ints);
+    delete_list(&f->list);
+    f->list = from_array(f->n, arr);
+    free(arr);
+}
+
+static void b_equals(Fixture *f) {
+    f->result = clone(f->list);
+    sink += equals(f->list, f->result);
+}
+
+/* Other representations */
+
+static void b_ulist_from_array(Fixture *f) { UList *u = ulist_from_array(f->n, f->arr); ulist_delete_list(&u); }
+static void b_ulist_sum(Fixture *f) { sink += ulist_sum(f->ulist); }
+static void b_ulist_to_array_into(Fixture *f) { sink += ulist_to_array_into(f->ulist, f->arr, f->n); }
+static void b_ulist_append_array(Fixture *f) { UList *u = ulist_append_array(ulist_empty_list(), f->n, f->arr); ulist_delete_list(&u); }
+
+static void b_ulist_blocks_sum(Fixture *f) {
+    int *values;
+    int n;
+    UListBlocks blocks = ulist_blocks(f->ulist);
+    while ((n = ulist_next_block(&blocks, &values)) > 0) {
+        sink += sum_array(n, values);
+    }
+}
+static void b_ulist_index_of(Fixture *f) { sink += ulist_index_of(f->ulist, -1); }
+static void b_ulist_fold_left(Fixture *f) { sink += ulist_fold_left(0, f->ulist, add); }
+
+static void b_ulist_get(Fixture *f) {
+    unsigned x = 1;
+    for (int i = 0; i < f->calls; i++) {
+        x = x * 1103515245u + 12345u;
+        sink += ulist_get(f->ulist, (int) (x % (unsigned) f->n));
+    }
+}
+
+static void b_clist_from_array(Fixture *f) { CList *c = clist_from_array(f->n, f->arr); clist_delete_list(&c); }
+static void b_clist_sum(Fixture *f) { sink += clist_sum(f->clist); }
+static void b_clist_contains(Fixture *f) { sink += clist_contains(f->clist, f->n - 1); }
+static void b_clist_fold_left(Fixture *f) { sink += clist_fold_left(0, f->clist, add); }
+static void b_clist_to_array(Fixture *f) { free(clist_to_array(f->clist)); }
+
+static void b_save_list(Fixture *f) { sink += save_list(f->list, BENCH_FILE); }
+static void b_load_list(Fixture *f) { f->result = load_list(BENCH_FILE); }
+
+static void b_view_sum(Fixture *f) {
+    IView *view = open_view(BENCH_FILE);
+    sink += view_sum(view);
+    close_view(&view);
+}
+
+static void b_ivector_push_back(Fixture *f) {
+    IVector *v = ivector_empty_list();
+    for (int i = 0; i < f->n; i++) {
+        ivector_push_back(v, i);
+    }
+    ivector_delete_list(&v);
+}
+
+static void b_ivector_sum(Fixture *f) { sink += ivector_sum(f->ivector); }
+static void b_ivector_to_array_into(Fixture *f) { sink += ivector_to_array_into(f->ivector, f->arr, f->n); }
+
+static void b_ivector_blocks_sum(Fixture *f) {
+    int *values;
+    int n;
+    IVectorBlocks blocks = ivector_blocks(f->ivector, 1024);
+    while ((n = ivector_next_block(&blocks, &values)) > 0) {
+        sink += sum_array(n, values);
+    }
+}
+static void b_ivector_index_of(Fixture *f) { sink += ivector_index_of(f->ivector, -1); }
+static void b_ivector_fold_left(Fixture *f) { sink += ivector_fold_left(0, f->ivector, add); }
+
+static void b_ivector_get(Fixture *f) {
+    unsigned x = 1;
+    for (int i = 0; i < f->calls; i++) {
+        x = x * 1103515245u + 12345u;
+        sink += ivector_get(f->ivector, (int) (x % (unsigned) f->n));
+    }
+}
+
+static void b_dlist_pop_back(Fixture *f) {
+    for (int i = 0; i < f->calls; i++) {
+        sink += dlist_pop_back(f->dlist);
+    }
+}
+
+static void b_dlist_fold_right(Fixture *f) { sink += dlist_fold_right(0, f->dlist, add); }
+
+static void b_plist_from_array(Fixture *f) { PList *p = plist_from_array(f->n, f->arr); plist_release(&p); }
+static void b_plist_sum(Fixture *f) { sink += plist_sum(f->plist); }
+
+/* Each call makes a new version from the previous one; the old version is kept
+    alive by the fixture only for the first call. */
+static void b_plist_update(Fixture *f) {
+    unsigned x = 1;
+    PList *version = plist_retain(f->plist);
+    for (int i = 0; i < f->calls; i++) {
+        x = x * 1103515245u + 12345u;
+        PList *next = plist_update(version, (int) (x % (unsigned) f->n), i);
+        plist_release(&version);
+        version = next;
+    }
+    plist_release(&version);
+}
+
+static void b_plist_drop_n(Fixture *f) {
+    unsigned x = 1;
+    for (int i = 0; i < f->calls; i++) {
+        x = x * 1103515245u + 12345u;
+        PList *rest = plist_drop_n(f->plist, (int) (x % (unsigned) f->n));
+        sink += plist_get_size(rest);
+        plist_release(&rest);
+    }
+}
+
+/* Typed lists (tlist.h), against the int sums of IList above. */
+
+static void b_i64list_sum(Fixture *f) {
+    if (i64list_sum(f->i64list) != (int64_t) f->n * (f->n - 1) / 2) {
+        fprintf(stderr, "tlist.i64list_sum: wrong sum\n");
+        abort();
+    }
+}
+
+static void b_f64list_sum(Fixture *f) {
+    if (f64list_sum(f->f64list) != (double) f->n * (f->n - 1) / 2) {
+        fprintf(stderr, "tlist.f64list_sum: wrong sum\n");
+        abort();
+    }
+}
+
+/* Streams: every stage kind runs, with plain and with context callbacks. */
+
+static int is_small(int x) { return x < 10; }
+static int add_ctx(int x, void *ctx) { return x + *(int*) ctx; }
+static int inc_ctx(int x, void *ctx) { (void) ctx; return x + 1; }
+static int add_acc_ctx(int acc, int x, void *ctx) { (void) ctx; return acc + x; }
+
+/* The even numbers from 10 to n, each followed by a 0, which sum to m(m+1) - 20
+    for m = n/2. */
+static void b_stream_pipeline(Fixture *f) {
+    IStream *stream = stream_of(f->list);
+    stream = stream_map(stream, inc);
+    stream = stream_filter(stream, is_even);
+    stream = stream_filter_not(stream, is_negative);
+    stream = stream_drop(stream, 1);
+    stream = stream_drop_while(stream, is_small);
+    stream = stream_take_while(stream, is_non_negative);
+    stream = stream_take(stream, f->n);
+    stream = stream_intersperse(stream, 0);
+    long long m = f->n / 2;
+    if (stream_sum64(stream) != m * (m + 1) - 20) {
+        fprintf(stderr, "stream.pipeline: wrong sum\n");
+        abort();
+    }
+}
+
+static void b_stream_pipeline_ctx(Fixture *f) {
+    int one = 1, two = 2, three = 3, ten = 10, limit = f->n;
+    IStream *stream = stream_generate_n_ctx(0, add_ctx, f->n, &one);
+    stream = stream_map_ctx(stream, add_ctx, &one);
+    stream = stream_filter_ctx(stream, is_multiple, &two);
+    stream = stream_filter_not_ctx(stream, is_multiple, &three);
+    stream = stream_drop_while_ctx(stream, is_below, &ten);
+    stream = stream_take_while_ctx(stream, is_below, &limit);
+    sink += stream_fold_left_ctx(0, stream, add_acc_ctx, NULL);
+}
+
+static void b_stream_generate_while(Fixture *f) {
+    IStream *stream = stream_generate_while_ctx(0, inc_ctx, is_below, &f->n);
+    if (stream_count(stream) != f->n) {
+        fprintf(stderr, "stream.generate_while: wrong count\n");
+        abort();
+    }
+}
+
+static void b_stream_collect(Fixture *f) { f->result = stream_collect(stream_map(stream_range_step_ex(0, f->n, 1), inc)); }
+
+#ifdef ILIST_INSTRUMENT
+
+static int compare_ctx(int x, int y, void *ctx) { (void) ctx; return compare(x, y); }
+
+/* Instrumentation: lists built, derived, split and merged across pools must give
+    back every node they were counted for once they are deleted. */
+static void b_stats_balance(Fixture *f) {
+    IStats before;
+    IStats after;
+    stats_snapshot(&before);
+    IList *list = range_ex(0, f->n);
+    IList *evens = filter(list, is_even);
+    IList *rest = split_at(list, f->n / 2);
+    push_back(rest, -1);
+    insert(rest, 0, f->n);
+    delete(rest, 1);
+    union_sorted_move(list, evens);
+    IList *both = intersect_sorted(list, rest);
+    concat_move(list, rest);
+    sort_by_ctx(list, compare_ctx, NULL);
+    delete_list(&list);
+    delete_list(&evens);
+    delete_list(&rest);
+    delete_list(&both);
+    stats_snapshot(&after);
+    if (after.allocs - before.allocs != after.frees - before.frees || after.live != 0) {
+        stats_dump(stderr);
+        fprintf(stderr, "istats.balance: %lld allocs, %lld frees, %lld live nodes\n",
+                after.allocs - before.allocs, after.frees - before.frees, after.live);
+        abort();
+    }
+}
+
+#endif
+
+/* Concurrent queues: n values pass from producer to consumer threads. Producer p
+    sends p * per_producer + i for i = 0, 1, ...; every value must come out exactly
+    once, and each consumer must see the values of one producer in increasing order. */
+
+typedef struct {
+    CQueue *cqueue;
+    IList *list;
+    pthread_mutex_t lock;
+    int producers;
+    int per_producer;
+    int total;
+    atomic_int next_producer;
+    atomic_int popped;
+    atomic_int errors;
+    atomic_char *seen;
+} Exchange;
+
+/* Checks a value taken by a consumer; last holds the sequence it saw last per producer. */
+static void received(Exchange *ex, int value, int *last) {
+    int producer = value / ex->per_producer;
+    int seq = value % ex->per_producer;
+    if (value < 0 || value >= ex->total || seq <= last[producer]
+            || atomic_fetch_add_explicit(&ex->seen[value], 1, memory_order_relaxed) != 0) {
+        atomic_fetch_add_explicit(&ex->errors, 1, memory_order_relaxed);
+    }
+    last[producer] = seq;
+    atomic_fetch_add_explicit(&ex->popped, 1, memory_order_relaxed);
+}
+
+static int* new_last(Exchange *ex) {
+    int *last = (int*) malloc(ex->producers * sizeof(int));
+    for (int i = 0; i < ex->producers; i++) {
+        last[i] = -1;
+    }
+    return last;
+}
+
+static void* cqueue_producer(void *arg) {
+    Exchange *ex = (Exchange*) arg;
+    int base = atomic_fetch_add(&ex->next_producer, 1) * ex->per_producer;
+    for (int i = 0; i < ex->per_producer; i++) {
+        cqueue_push_back(ex->cqueue, base + i);
+    }
+    return NULL;
+}
+
+static void* cqueue_consumer(void *arg) {
+    Exchange *ex = (Exchange*) arg;
+    int *last = new_last(ex);
+    int value;
+    while (atomic_load_explicit(&ex->popped, memory_order_relaxed) < ex->total) {
+        if (cqueue_pop(ex->cqueue, &value)) {
+            received(ex, value, last);
+        }
+    }
+    free(last);
+    return NULL;
+}
+
+static void* mutex_producer(void *arg) {
+    Exchange *ex = (Exchange*) arg;
+    int base = atomic_fetch_add(&ex->next_producer, 1) * ex->per_producer;
+    for (int i = 0; i < ex->per_producer; i++) {
+        pthread_mutex_lock(&ex->lock);
+        push_back(ex->list, base + i);
+        pthread_mutex_unlock(&ex->lock);
+    }
+    return NULL;
+}
+
+static void* mutex_consumer(void *arg) {
+    Exchange *ex = (Exchange*) arg;
+    int *last = new_last(ex);
+    while (atomic_load_explicit(&ex->popped, memory_order_relaxed) < ex->total) {
+        pthread_mutex_lock(&ex->lock);
+        int got = is_not_empty(ex->list);
+        int value = got ? pop(ex->list) : 0;
+        pthread_mutex_unlock(&ex->lock);
+        if (got) {
+            received(ex, value, last);
+        }
+    }
+    free(last);
+    return NULL;
+}
+
+static void exchange(Fixture *f, int threads, int lock_free) {
+    Exchange ex;
+    ex.producers = threads;
+    ex.per_producer = f->n / threads;
+    ex.total = ex.per_producer * threads;
+    atomic_init(&ex.next_producer, 0);
+    atomic_init(&ex.popped, 0);
+    atomic_init(&ex.errors, 0);
+    ex.seen = (atomic_char*) calloc(ex.total, sizeof(atomic_char));
+    if (lock_free) {
+        ex.cqueue = cqueue_empty_list();
+    } else {
+        ex.list = empty_list();
+        pthread_mutex_init(&ex.lock, NULL);
+    }
+    pthread_t workers[2 * threads];
+    for (int i = 0; i < threads; i++) {
+        pthread_create(&workers[i], NULL, lock_free ? cqueue_producer : mutex_producer, &ex);
+        pthread_create(&workers[threads + i], NULL, lock_free ? cqueue_consumer : mutex_consumer, &ex);
+    }
+    for (int i = 0; i < 2 * threads; i++) {
+        pthread_join(workers[i], NULL);
+    }
+    int missing = 0;
+    for (int i = 0; i < ex.total; i++) {
+        missing += atomic_load_explicit(&ex.seen[i], memory_order_relaxed) == 0;
+    }
+    if (atomic_load(&ex.errors) || missing) {
+        fprintf(stderr, "%s queue: %d values duplicated or out of order, %d lost\n",
+                lock_free ? "lock-free" : "mutex", atomic_load(&ex.errors), missing);
+        abort();
+    }
+    free(ex.seen);
+    if (lock_free) {
+        cqueue_delete_list(&ex.cqueue);
+    } else {
+        delete_list(&ex.list);
+        pthread_mutex_destroy(&ex.lock);
+    }
+}
+
+static void b_cqueue_1x1(Fixture *f) { exchange(f, 1, 1); }
+static void b_cqueue_4x4(Fixture *f) { exchange(f, 4, 1); }
+static void b_mutex_1x1(Fixture *f) { exchange(f, 1, 0); }
+static void b_mutex_4x4(Fixture *f) { exchange(f, 4, 0); }
+
+/* Inline mode: from here on the accessors and traversals of IList are the inline
+    definitions of ilist_inline.h, to compare with the library calls above. */
+
+#include "ilist_inline.h"
+
+static void b_inline_count(Fixture *f) {
+    if (count(f->list, is_even) != (f->n + 1) / 2) {
+        fprintf(stderr, "inline.count: wrong count\n");
+        abort();
+    }
+}
+
+static void b_inline_sum(Fixture *f) {
+    if (sum(f->list) != (int) ((unsigned) f->n * (unsigned) (f->n - 1) / 2)) {
+        fprintf(stderr, "inline.sum: wrong sum\n");
+        abort();
+    }
+}
+
+static void b_inline_fold_left(Fixture *f) { sink += fold_left(0, f->list, add); }
+
+static const Bench benches[] = {
+    { "ilist", "range", SETUP_NONE, 0, b_range },
+    { "ilist", "from_array", SETUP_ARRAY, 0, b_from_array },
+    { "ilist", "repeat", SETUP_NONE, 0, b_repeat },
+    { "ilist", "generate_n", SETUP_NONE, 0, b_generate_n },
+    { "ilist", "clone", SETUP_LIST, 0, b_clone },
+    { "ilist", "to_array", SETUP_LIST, 0, b_to_array },
+    { "ilist", "to_array_into", SETUP_EXPORT, 0, b_to_array_into },
+    { "ilist", "append_array", SETUP_ARRAY, 0, b_append_array },
+    { "ilist", "blocks_sum", SETUP_LIST, 0, b_blocks_sum },
+    { "ilist", "delete_list", SETUP_LIST, 0, b_delete_list },
+    { "ilist", "push", SETUP_NONE, 0, b_push },
+    { "ilist", "push_back", SETUP_NONE, 0, b_push_back },
+    { "ilist", "push_back_tracked", SETUP_NONE, 0, b_push_back_tracked },
+    { "ilist", "pop", SETUP_LIST, 0, b_pop },
+    { "ilist", "pop_back", SETUP_LIST, 1, b_pop_back },
+    { "ilist", "drop_back_n", SETUP_LIST, 1, b_drop_back_n },
+    { "ilist", "get", SETUP_LIST, 1, b_get },
+    { "ilist", "update", SETUP_LIST, 1, b_update },
+    { "ilist", "insert", SETUP_LIST, 1, b_insert },
+    { "ilist", "delete", SETUP_LIST, 1, b_delete },
+    { "ilist", "swap", SETUP_LIST, 1, b_swap },
+    { "ilist", "get_indexed", SETUP_INDEXED, 1, b_get },
+    { "ilist", "update_indexed", SETUP_INDEXED, 1, b_update },
+    { "ilist", "insert_indexed", SETUP_INDEXED, 1, b_insert },
+    { "ilist", "delete_indexed", SETUP_INDEXED, 1, b_delete },
+    { "ilist", "swap_indexed", SETUP_INDEXED, 1, b_swap },
+    { "ilist", "pop_back_indexed", SETUP_INDEXED, 1, b_pop_back },
+    { "ilist", "mixed_indexed", SETUP_INDEXED, 1, b_mixed_indexed },
+    { "ilist", "map", SETUP_LIST, 0, b_map },
+    { "ilist", "filter", SETUP_LIST, 0, b_filter },
+    { "ilist", "foreach", SETUP_LIST, 0, b_foreach },
+    { "ilist", "fold_left", SETUP_LIST, 0, b_fold_left },
+    { "ilist", "fold_right", SETUP_LIST, 0, b_fold_right },
+    { "ilist", "reduce_right", SETUP_LIST, 0, b_reduce_right },
+    { "ilist", "count", SETUP_LIST, 0, b_count },
+    { "ilist", "count_ctx", SETUP_LIST, 0, b_count_ctx },
+    { "ilist", "count_macro", SETUP_LIST, 0, b_count_macro },
+    { "ilist", "forall", SETUP_LIST, 0, b_forall },
+    { "ilist", "exists", SETUP_LIST, 0, b_exists },
+    { "ilist", "sum", SETUP_LIST, 0, b_sum },
+    { "ilist", "sum64", SETUP_LIST, 0, b_sum64 },
+    { "ilist", "max", SETUP_LIST, 0, b_max },
+    { "ilist", "min", SETUP_LIST, 0, b_min },
+    { "ilist", "contains", SETUP_LIST, 0, b_contains },
+    { "ilist", "sum_tracked", SETUP_TRACKED, 1, b_sum_tracked },
+    { "ilist", "max_tracked", SETUP_TRACKED, 1, b_max_tracked },
+    { "ilist", "min_tracked", SETUP_TRACKED, 1, b_min_tracked },
+    { "ilist", "contains_tracked", SETUP_TRACKED, 1, b_contains_tracked },
+    { "ilist", "mixed_tracked", SETUP_TRACKED, 1, b_mixed_tracked },
+    { "ilist", "index_of", SETUP_LIST, 0, b_index_of },
+    { "ilist", "equals", SETUP_LIST, 0, b_equals },
+    { "ilist", "reverse", SETUP_LIST, 0, b_reverse },
+    { "ilist", "take", SETUP_LIST, 0, b_take },
+    { "ilist", "take_right_while", SETUP_LIST, 0, b_take_right_while },
+    { "ilist", "slice", SETUP_LIST, 0, b_slice },
+    { "ilist", "intersperse", SETUP_LIST, 0, b_intersperse },
+    { "ilist", "unique", SETUP_DUPLICATES, 0, b_unique },
+    { "ilist", "distinct", SETUP_DUPLICATES, 0, b_distinct },
+    { "ilist", "remove_if", SETUP_LIST, 0, b_remove_if },
+    { "ilist", "partition", SETUP_LIST, 0, b_partition },
+    { "ilist", "dedup_adjacent", SETUP_DUPLICATES, 0, b_dedup_adjacent },
+    { "ilist", "map_into", SETUP_SETS, 0, b_map_into },
+    { "ilist", "delete_item", SETUP_DUPLICATES, 0, b_delete_item },
+    { "ilist", "is_suffix", SETUP_LIST, 0, b_is_suffix },
+    { "ilist", "is_sublist", SETUP_PATTERN, 0, b_is_sublist },
+    { "ilist", "add_all", SETUP_SETS, 0, b_add_all },
+    { "ilist", "concat_move", SETUP_SETS, 0, b_concat_move },
+    { "ilist", "split_at", SETUP_LIST, 0, b_split_at },
+    { "ilist", "union_sorted", SETUP_SETS, 0, b_union_sorted },
+    { "ilist", "union_sorted_move", SETUP_SETS, 0, b_union_sorted_move },
+    { "ilist", "intersect_sorted", SETUP_SETS, 0, b_intersect_sorted },
+    { "ilist", "intersect_unsorted", SETUP_SETS, 0, b_intersect_unsorted },
+    { "ilist", "set_ops", SETUP_SETS, 0, b_set_ops },
+    { "ilist", "sort", SETUP_DUPLICATES, 0, b_sort },
+    { "ilist", "sort_by", SETUP_DUPLICATES, 0, b_sort_by },
+    { "ilist", "radix_sort", SETUP_DUPLICATES, 0, b_radix_sort },
+    { "ilist", "qsort_copy", SETUP_DUPLICATES, 0, b_qsort_copy },
+    { "ulist", "from_array", SETUP_ARRAY, 0, b_ulist_from_array },
+    { "ulist", "sum", SETUP_ULIST, 0, b_ulist_sum },
+    { "ulist", "to_array_into", SETUP_ULIST, 0, b_ulist_to_array_into },
+    { "ulist", "append_array", SETUP_ARRAY, 0, b_ulist_append_array },
+    { "ulist", "blocks_sum", SETUP_ULIST, 0, b_ulist_blocks_sum },
+    { "ulist", "index_of", SETUP_ULIST, 0, b_ulist_index_of },
+    { "ulist", "fold_left", SETUP_ULIST, 0, b_ulist_fold_left },
+    { "ulist", "get", SETUP_ULIST, 1, b_ulist_get },
+    { "clist", "from_array", SETUP_ARRAY, 0, b_clist_from_array },
+    { "clist", "sum", SETUP_CLIST, 0, b_clist_sum },
+    { "clist", "contains", SETUP_CLIST, 0, b_clist_contains },
+    { "clist", "fold_left", SETUP_CLIST, 0, b_clist_fold_left },
+    { "clist", "to_array", SETUP_CLIST, 0, b_clist_to_array },
+    { "ifile", "save_list", SETUP_LIST, 0, b_save_list },
+    { "ifile", "load_list", SETUP_FILE, 0, b_load_list },
+    { "ifile", "view_sum", SETUP_FILE, 0, b_view_sum },
+    { "ivector", "push_back", SETUP_NONE, 0, b_ivector_push_back },
+    { "ivector", "sum", SETUP_IVECTOR, 0, b_ivector_sum },
+    { "ivector", "to_array_into", SETUP_IVECTOR, 0, b_ivector_to_array_into },
+    { "ivector", "blocks_sum", SETUP_IVECTOR, 0, b_ivector_blocks_sum },
+    { "ivector", "index_of", SETUP_IVECTOR, 0, b_ivector_index_of },
+    { "ivector", "fold_left", SETUP_IVECTOR, 0, b_ivector_fold_left },
+    { "ivector", "get", SETUP_IVECTOR, 1, b_ivector_get },
+    { "dlist", "pop_back", SETUP_DLIST, 1, b_dlist_pop_back },
+    { "dlist", "fold_right", SETUP_DLIST, 0, b_dlist_fold_right },
+    { "plist", "from_array", SETUP_ARRAY, 0, b_plist_from_array },
+    { "plist", "sum", SETUP_PLIST, 0, b_plist_sum },
+    { "plist", "update", SETUP_PLIST, 1, b_plist_update },
+    { "plist", "drop_n", SETUP_PLIST, 1, b_plist_drop_n },
+    { "tlist", "i64list_sum", SETUP_TLIST, 0, b_i64list_sum },
+    { "tlist", "f64list_sum", SETUP_TLIST, 0, b_f64list_sum },
+    { "inline", "count", SETUP_LIST, 0, b_inline_count },
+    { "inline", "sum", SETUP_LIST, 0, b_inline_sum },
+    { "inline", "fold_left", SETUP_LIST, 0, b_inline_fold_left },
+    { "stream", "pipeline", SETUP_LIST, 0, b_stream_pipeline },
+    { "stream", "pipeline_ctx", SETUP_NONE, 0, b_stream_pipeline_ctx },
+    { "stream", "generate_while", SETUP_NONE, 0, b_stream_generate_while },
+    { "stream", "collect", SETUP_NONE, 0, b_stream_collect },
+#ifdef ILIST_INSTRUMENT
+    { "istats", "balance", SETUP_NONE, 0, b_stats_balance },
+#endif
+    { "cqueue", "mpmc_1x1", SETUP_NONE, 0, b_cqueue_1x1 },
+    { "cqueue", "mpmc_4x4", SETUP_NONE, 0, b_cqueue_4x4 },
+    { "cqueue", "mutex_1x1", SETUP_NONE, 0, b_mutex_1x1 },
+    { "cqueue", "mutex_4x4", SETUP_NONE, 0, b_mutex_4x4 },
+};
+
+static double now_ns() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static long max_rss_kb() {
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+}
+
+static void run_bench(const Bench *bench, int n, int json, int *first) {
+    /* repeat small sizes so that every measurement covers about 1e6 elements */
+    int reps = n < 1000000 && !bench->per_call ? 1000000 / n : 1;
+    double total_ns = 0;
+    long total_allocs = 0;
+    long total_frees = 0;
+    long peak = 0;
+    long units = 0;
+    for (int r = 0; r < reps; r++) {
+        Fixture f;
+        long before_setup = live_bytes;
+        setup(&f, bench->setup, n);
+        long start_allocs = allocs;
+        long start_frees = frees;
+        peak_bytes = live_bytes;
+        long start_bytes = live_bytes;
+        double start = now_ns();
+        bench->run(&f);
+        total_ns += now_ns() - start;
+        total_allocs += allocs - start_allocs;
+        total_frees += frees - start_frees;
+        if (peak_bytes - start_bytes > peak) {
+            peak = peak_bytes - start_bytes;
+        }
+        units += bench->per_call ? f.calls : n;
+        teardown(&f);
+        /* everything a benchmark allocates must be freed again; the concurrent
+            queue keeps its hazard records for the life of the process */
+        if (live_bytes != before_setup && strcmp(bench->group, "cqueue") != 0) {
+            fprintf(stderr, "%s.%s: %ld bytes leaked at n = %d\n", bench->group, bench->name,
+                    live_bytes - before_setup, n);
+            abort();
+        }
+    }
+    const char *unit = bench->per_call ? "call" : "element";
+    if (json) {
+        printf("%s\n    {\"group\": \"%s\", \"name\": \"%s\", \"n\": %d, \"unit\": \"%s\", "
+               "\"ns_per_unit\": %.3f, \"allocs_per_unit\": %.4f, \"frees_per_unit\": %.4f, "
+               "\"peak_heap_bytes\": %ld, \"max_rss_kb\": %ld}",
+               *first ? "" : ",", bench->group, bench->name, n, unit,
+               total_ns / units, (double) total_allocs / units, (double) total_frees / units,
+               peak, max_rss_kb());
+    } else {
+        printf("%-8s %-18s %9d %12.3f ns/%-7s %8.4f allocs/%-7s %12ld B peak %9ld KB rss\n",
+               bench->group, bench->name, n, total_ns / units, unit,
+               (double) total_allocs / units, unit, peak, max_rss_kb());
+    }
+    fflush(stdout);
+    *first = 0;
+}
+
+int main(int argc, char **argv) {
+    int json = 0;
+    int min_n = 1000;
+    int max_n = 10000000;
+    const char *only = NULL;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--json") == 0) {
+            json = 1;
+        } else if (strcmp(argv[i], "--min") == 0 && i + 1 < argc) {
+            min_n = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--max") == 0 && i + 1 < argc) {
+            max_n = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--filter") == 0 && i + 1 < argc) {
+            only = argv[++i];
+        } else {
+            fprintf(stderr, "usage: %s [--json] [--min N] [--max N] [--filter SUBSTRING]\n", argv[0]);
+            return 1;
+        }
+    }
+    int first = 1;
+    if (json) {
+        printf("{\n  \"isa\": \"%s\",\n  \"timestamp\": %ld,\n  \"results\": [", reduce_isa(), (long) time(NULL));
+    }
+    for (size_t b = 0; b < sizeof(benches) / sizeof(benches[0]); b++) {
+        char full[64];
+        snprintf(full, sizeof(full), "%s.%s", benches[b].group, benches[b].name);
+        if (only && !strstr(full, only)) {
+            continue;
+        }
+        for (int n = 1000; n <= max_n && n > 0; n *= 10) {
+            if (n >= min_n) {
+                run_bench(&benches[b], n, json, &first);
+            }
+        }
+    }
+    if (json) {
+        printf("\n  ]\n}\n");
+    }
+#ifdef ILIST_INSTRUMENT
+    stats_dump(stderr);
+#endif
+    return 0;
+}
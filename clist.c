@@ -0,0 +1,320 @@
+#include <stdlib.h>
+#include "clist.h"
+#include "ireduce.h"
+#include "icallback.h"
+
+/* A 32-bit value takes at most 5 bytes of 7 bits. */
+#define MAX_VARINT 5
+
+static unsigned zigzag(unsigned delta) {
+    return (delta << 1) ^ (0u - (delta >> 31));
+}
+
+static unsigned unzigzag(unsigned code) {
+    return (code >> 1) ^ (0u - (code & 1));
+}
+
+static int put_varint(unsigned char *bytes, unsigned code) {
+    int length = 0;
+    while (code >= 0x80) {
+        bytes[length++] = (unsigned char) (code | 0x80);
+        code >>= 7;
+    }
+    bytes[length++] = (unsigned char) code;
+    return length;
+}
+
+static unsigned get_varint(const unsigned char *bytes, int *offset) {
+    unsigned code = 0;
+    int shift = 0;
+    unsigned char byte;
+    do {
+        byte = bytes[(*offset)++];
+        code |= (unsigned) (byte & 0x7F) << shift;
+        shift += 7;
+    } while (byte & 0x80);
+    return code;
+}
+
+/* Decodes the values of the block into the array and returns their number. */
+static int decode_block(CBlock *block, int *values) {
+    unsigned value = (unsigned) block->first;
+    int offset = 0;
+    values[0] = block->first;
+    for (int i = 1; i < block->count; i++) {
+        value += unzigzag(get_varint(block->bytes, &offset));
+        values[i] = (int) value;
+    }
+    return block->count;
+}
+
+static CBlock* first_block(CList *list) {
+    return list->first ? list->first : list->open;
+}
+
+/* Returns the block after this one: the sealed blocks come first, then the open one. */
+static CBlock* next_block(CList *list, CBlock *block) {
+    if (block == list->open) {
+        return NULL;
+    }
+    return block->next ? block->next : list->open;
+}
+
+/* Shrinks the full open block to its encoded length and links it after the sealed blocks. */
+static void seal(CList *list) {
+    CBlock *block = (CBlock*) realloc(list->open, sizeof(CBlock) + list->open->length);
+    if (list->last) {
+        list->last->next = block;
+    } else {
+        list->first = block;
+    }
+    list->last = block;
+    list->open = NULL;
+}
+
+CList* clist_empty_list() {
+    CList *list = (CList*) malloc(sizeof(CList));
+    list->first = NULL;
+    list->last = NULL;
+    list->open = NULL;
+    list->last_value = 0;
+    list->size = 0;
+    return list;
+}
+
+CList* clist_from_array(int size, int *arr) {
+    return clist_add_array(clist_empty_list(), size, arr);
+}
+
+CList* clist_from_ilist(IList *list) {
+    CList *result = clist_empty_list();
+    for (Node *cur = list->first; cur; cur = cur->next) {
+        clist_push_back(result, cur->value);
+    }
+    return result;
+}
+
+void clist_delete_list(CList **list) {
+    CBlock *block = (*list)->first;
+    while (block) {
+        CBlock *next = block->next;
+        free(block);
+        block = next;
+    }
+    free((*list)->open);
+    free(*list);
+    *list = NULL;
+}
+
+int clist_is_empty(CList *list) {
+    return list->size == 0;
+}
+
+int clist_get_size(CList *list) {
+    return list->size;
+}
+
+long clist_memory_size(CList *list) {
+    long size = sizeof(CList);
+    for (CBlock *block = list->first; block; block = block->next) {
+        size += sizeof(CBlock) + block->length;
+    }
+    if (list->open) {
+        size += sizeof(CBlock) + CLIST_BLOCK * MAX_VARINT;
+    }
+    return size;
+}
+
+CList* clist_push_back(CList *list, int value) {
+    CBlock *block = list->open;
+    if (!block) {
+        block = (CBlock*) malloc(sizeof(CBlock) + CLIST_BLOCK * MAX_VARINT);
+        block->next = NULL;
+        block->sum = 0;
+        block->first = value;
+        block->min = value;
+        block->max = value;
+        block->count = 0;
+        block->length = 0;
+        list->open = block;
+    } else {
+        unsigned delta = (unsigned) value - (unsigned) list->last_value;
+        block->length += put_varint(block->bytes + block->length, zigzag(delta));
+        if (value < block->min) {
+            block->min = value;
+        }
+        if (value > block->max) {
+            block->max = value;
+        }
+    }
+    block->sum += value;
+    block->count++;
+    list->last_value = value;
+    list->size++;
+    if (block->count == CLIST_BLOCK) {
+        seal(list);
+    }
+    return list;
+}
+
+CList* clist_add_array(CList *list, int size, int *arr) {
+    for (int i = 0; i < size; i++) {
+        clist_push_back(list, arr[i]);
+    }
+    return list;
+}
+
+CListCursor clist_cursor(CList *list) {
+    CListCursor cursor = { list, first_block(list), 0, 0, 0 };
+    return cursor;
+}
+
+int clist_next(CListCursor *cursor, int *value) {
+    while (cursor->block && cursor->index == cursor->block->count) {
+        cursor->block = next_block(cursor->list, cursor->block);
+        cursor->index = 0;
+        cursor->offset = 0;
+    }
+    if (!cursor->block) {
+        return 0;
+    }
+    if (cursor->index == 0) {
+        cursor->value = cursor->block->first;
+    } else {
+        unsigned delta = unzigzag(get_varint(cursor->block->bytes, &cursor->offset));
+        cursor->value = (int) ((unsigned) cursor->value + delta);
+    }
+    cursor->index++;
+    *value = cursor->value;
+    return 1;
+}
+
+void clist_foreach(CList *list, void (*op)(int)) {
+    int values[CLIST_BLOCK];
+    for (CBlock *block = first_block(list); block; block = next_block(list, block)) {
+        int count = decode_block(block, values);
+        for (int i = 0; i < count; i++) {
+            op(values[i]);
+        }
+    }
+}
+
+void clist_foreach_ctx(CList *list, void (*op)(int, void*), void *ctx) {
+    int values[CLIST_BLOCK];
+    for (CBlock *block = first_block(list); block; block = next_block(list, block)) {
+        int count = decode_block(block, values);
+        for (int i = 0; i < count; i++) {
+            op(values[i], ctx);
+        }
+    }
+}
+
+static int fold_with(int init, CList *list, const BiCallback *op) {
+    int values[CLIST_BLOCK];
+    int acc = init;
+    for (CBlock *block = first_block(list); block; block = next_block(list, block)) {
+        int count = decode_block(block, values);
+        for (int i = 0; i < count; i++) {
+            acc = combine(op, acc, values[i]);
+        }
+    }
+    return acc;
+}
+
+int clist_fold_left(int init, CList *list, i_bifunc op) {
+    return fold_with(init, list, PLAIN2(op));
+}
+
+int clist_fold_left_ctx(int init, CList *list, i_bifunc_ctx op, void *ctx) {
+    return fold_with(init, list, WITH_CTX2(op, ctx));
+}
+
+static int count_where(CList *list, const Callback *pred) {
+    int values[CLIST_BLOCK];
+    int result = 0;
+    for (CBlock *block = first_block(list); block; block = next_block(list, block)) {
+        int count = decode_block(block, values);
+        for (int i = 0; i < count; i++) {
+            if (apply(pred, values[i])) {
+                result++;
+            }
+        }
+    }
+    return result;
+}
+
+int clist_count(CList *list, i_func pred) {
+    return count_where(list, PLAIN(pred));
+}
+
+int clist_count_ctx(CList *list, i_func_ctx pred, void *ctx) {
+    return count_where(list, WITH_CTX(pred, ctx));
+}
+
+int clist_contains(CList *list, int value) {
+    int values[CLIST_BLOCK];
+    for (CBlock *block = first_block(list); block; block = next_block(list, block)) {
+        if (value >= block->min && value <= block->max) {
+            int count = decode_block(block, values);
+            if (contains_array(count, values, value)) {
+                return 1;
+            }
+        }
+    }
+    return 0;
+}
+
+int clist_max(CList *list) {
+    CBlock *block = first_block(list);
+    int result = block->max;
+    for (block = next_block(list, block); block; block = next_block(list, block)) {
+        if (block->max > result) {
+            result = block->max;
+        }
+    }
+    return result;
+}
+
+int clist_min(CList *list) {
+    CBlock *block = first_block(list);
+    int result = block->min;
+    for (block = next_block(list, block); block; block = next_block(list, block)) {
+        if (block->min < result) {
+            result = block->min;
+        }
+    }
+    return result;
+}
+
+int clist_sum(CList *list) {
+    return (int) (unsigned) clist_sum64(list);
+}
+
+long long clist_sum64(CList *list) {
+    long long sum = 0;
+    for (CBlock *block = first_block(list); block; block = next_block(list, block)) {
+        sum += block->sum;
+    }
+    return sum;
+}
+
+IList* clist_to_ilist(CList *list) {
+    int values[CLIST_BLOCK];
+    IList *result = empty_list();
+    for (CBlock *block = first_block(list); block; block = next_block(list, block)) {
+        int count = decode_block(block, values);
+        for (int i = 0; i < count; i++) {
+            push_back(result, values[i]);
+        }
+    }
+    return result;
+}
+
+int* clist_to_array(CList *list) {
+    int *result = (int*) malloc(list->size * sizeof(int));
+    int size = 0;
+    for (CBlock *block = first_block(list); block; block = next_block(list, block)) {
+        size += decode_block(block, result + size);
+    }
+    return result;
+}
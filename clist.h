@@ -0,0 +1,122 @@
+#ifndef CLIST_H_
+#define CLIST_H_
+
+#include "ilist.h"
+
+/* Compressed Integer List (append-only)
+
+    Values are stored in blocks of CLIST_BLOCK. A block keeps its first value
+    as is and every following value as the difference to its predecessor,
+    zigzag encoded so that small negative differences stay small, in a
+    variable-length encoding of 7 bits per byte. Sorted or slowly varying
+    values take one or two bytes each instead of a 16-byte node.
+
+    Every block also records the minimum, maximum and sum of its values, so
+    sum, min and max read no encoded data and contains skips whole blocks.
+    The last block stays open for appends and is shrunk to size once full. */
+
+/* Values per block. */
+#define CLIST_BLOCK 128
+
+typedef struct CBlock {
+    struct CBlock *next;
+    long long sum;
+    int first;
+    int min;
+    int max;
+    int count;
+    int length;
+    unsigned char bytes[];
+} CBlock;
+
+typedef struct {
+    CBlock *first;
+    CBlock *last;
+    CBlock *open;
+    int last_value;
+    int size;
+} CList;
+
+/* Reads the values of a list one by one. The list must not change while it is read. */
+typedef struct {
+    CList *list;
+    CBlock *block;
+    int index;
+    int offset;
+    int value;
+} CListCursor;
+
+/* Returns a empty list. */
+extern CList* clist_empty_list();
+
+/* Returns a list containing the elements of the array. */
+extern CList* clist_from_array(int, int*);
+
+/* Returns a list containing the elements of the IList. */
+extern CList* clist_from_ilist(IList*);
+
+/* Delete the list. */
+extern void clist_delete_list(CList**);
+
+/* Returns true if this list contains no elements. */
+extern int clist_is_empty(CList*);
+
+/* Returns a size of the list. */
+extern int clist_get_size(CList*);
+
+/* Returns the number of bytes taken by the list, including block headers. */
+extern long clist_memory_size(CList*);
+
+/* [Mutator] Adds an element to the end of the list. */
+extern CList* clist_push_back(CList*, int);
+
+/* [Mutator] Adds the elements of the array to the end of the list. */
+extern CList* clist_add_array(CList*, int, int*);
+
+/* Returns a cursor before the first element of the list. */
+extern CListCursor clist_cursor(CList*);
+
+/* Stores the next element into the second argument and returns true,
+    or returns false if there are no more elements. */
+extern int clist_next(CListCursor*, int*);
+
+/* Performs the given action for each element of the list. */
+extern void clist_foreach(CList*, void (*op)(int));
+
+/* clist_foreach with an action that receives the context. */
+extern void clist_foreach_ctx(CList*, void (*op)(int, void*), void*);
+
+/* Applies a binary operator to a start value and all elements of the list, going left to right. */
+extern int clist_fold_left(int, CList*, i_bifunc);
+
+/* clist_fold_left with an operator that receives the context. */
+extern int clist_fold_left_ctx(int, CList*, i_bifunc_ctx, void*);
+
+/* Counts the number of elements in the list which satisfy a predicate. */
+extern int clist_count(CList*, i_func);
+
+/* clist_count with a predicate that receives the context. */
+extern int clist_count_ctx(CList*, i_func_ctx, void*);
+
+/* Returns true if the list contains the specified element. */
+extern int clist_contains(CList*, int);
+
+/* Finds the largest element in the list. */
+extern int clist_max(CList*);
+
+/* Finds the smallest element in the list. */
+extern int clist_min(CList*);
+
+/* Sums up the elements of the list. */
+extern int clist_sum(CList*);
+
+/* Sums up the elements of the list into a 64-bit accumulator. */
+extern long long clist_sum64(CList*);
+
+/* Returns an IList containing the elements of the list. */
+extern IList* clist_to_ilist(CList*);
+
+/* Returns an array containing the elements of the list. */
+extern int* clist_to_array(CList*);
+
+#endif
@@ -0,0 +1,254 @@
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include "cqueue.h"
+
+/* Hazard pointers per thread: the head (or tail) and the node after it. */
+#define HAZARDS 2
+
+/* Removed nodes a thread keeps before it looks for ones it can free. */
+#define RETIRE_BATCH 64
+
+typedef struct QNode {
+    int value;
+    _Atomic(struct QNode*) next;
+} QNode;
+
+/* The head and tail are changed by different threads, so they live on separate cache lines. */
+struct CQueue {
+    _Alignas(64) _Atomic(QNode*) head;
+    _Alignas(64) _Atomic(QNode*) tail;
+    _Alignas(64) atomic_int size;
+};
+
+/* The hazard pointers and removed nodes of one thread. Records are never
+    freed: when a thread exits, the next new thread takes its record over
+    together with the nodes it could not free yet. */
+typedef struct HazardRecord {
+    _Atomic(QNode*) hazards[HAZARDS];
+    atomic_int active;
+    struct HazardRecord *next;
+    QNode **retired;
+    int retired_count;
+    int retired_capacity;
+    QNode **scratch;
+    int scratch_capacity;
+} HazardRecord;
+
+static _Atomic(HazardRecord*) records;
+static atomic_int record_count;
+static pthread_key_t record_key;
+static pthread_once_t record_once = PTHREAD_ONCE_INIT;
+static _Thread_local HazardRecord *mine;
+
+static int compare_nodes(const void *a, const void *b) {
+    uintptr_t x = (uintptr_t) *(QNode* const*) a;
+    uintptr_t y = (uintptr_t) *(QNode* const*) b;
+    return (x > y) - (x < y);
+}
+
+/* Frees the removed nodes of the record that no hazard pointer refers to. */
+static void scan(HazardRecord *rec) {
+    int count = 0;
+    for (HazardRecord *cur = atomic_load(&records); cur; cur = cur->next) {
+        for (int i = 0; i < HAZARDS; i++) {
+            QNode *node = atomic_load(&cur->hazards[i]);
+            if (!node) {
+                continue;
+            }
+            if (count == rec->scratch_capacity) {
+                rec->scratch_capacity = rec->scratch_capacity ? rec->scratch_capacity * 2 : 16;
+                rec->scratch = (QNode**) realloc(rec->scratch, rec->scratch_capacity * sizeof(QNode*));
+            }
+            rec->scratch[count++] = node;
+        }
+    }
+    if (count) {
+        qsort(rec->scratch, count, sizeof(QNode*), compare_nodes);
+    }
+    int kept = 0;
+    for (int i = 0; i < rec->retired_count; i++) {
+        QNode *node = rec->retired[i];
+        if (count && bsearch(&node, rec->scratch, count, sizeof(QNode*), compare_nodes)) {
+            rec->retired[kept++] = node;
+        } else {
+            free(node);
+        }
+    }
+    rec->retired_count = kept;
+}
+
+static void release_record(void *arg) {
+    HazardRecord *rec = (HazardRecord*) arg;
+    for (int i = 0; i < HAZARDS; i++) {
+        atomic_store(&rec->hazards[i], NULL);
+    }
+    scan(rec);
+    atomic_store(&rec->active, 0);
+}
+
+static void make_key() {
+    pthread_key_create(&record_key, release_record);
+}
+
+/* Returns the record of the calling thread, taking over an inactive one or adding a new one. */
+static HazardRecord* my_record() {
+    if (mine) {
+        return mine;
+    }
+    pthread_once(&record_once, make_key);
+    for (HazardRecord *rec = atomic_load(&records); rec && !mine; rec = rec->next) {
+        int expected = 0;
+        if (atomic_compare_exchange_strong(&rec->active, &expected, 1)) {
+            mine = rec;
+        }
+    }
+    if (!mine) {
+        HazardRecord *rec = (HazardRecord*) calloc(1, sizeof(HazardRecord));
+        atomic_init(&rec->active, 1);
+        rec->next = atomic_load(&records);
+        while (!atomic_compare_exchange_weak(&records, &rec->next, rec));
+        atomic_fetch_add(&record_count, 1);
+        mine = rec;
+    }
+    pthread_setspecific(record_key, mine);
+    return mine;
+}
+
+/* Publishes the node that src points to in the hazard pointer and returns it
+    once src still points to it, so the node cannot be freed while it is used. */
+static QNode* protect(HazardRecord *rec, int i, _Atomic(QNode*) *src) {
+    QNode *node = atomic_load(src);
+    while (1) {
+        atomic_store(&rec->hazards[i], node);
+        QNode *again = atomic_load(src);
+        if (again == node) {
+            return node;
+        }
+        node = again;
+    }
+}
+
+static void clear_hazards(HazardRecord *rec) {
+    for (int i = 0; i < HAZARDS; i++) {
+        atomic_store_explicit(&rec->hazards[i], NULL, memory_order_release);
+    }
+}
+
+static void retire(HazardRecord *rec, QNode *node) {
+    if (rec->retired_count == rec->retired_capacity) {
+        rec->retired_capacity = rec->retired_capacity ? rec->retired_capacity * 2 : RETIRE_BATCH;
+        rec->retired = (QNode**) realloc(rec->retired, rec->retired_capacity * sizeof(QNode*));
+    }
+    rec->retired[rec->retired_count++] = node;
+    if (rec->retired_count >= RETIRE_BATCH + 2 * HAZARDS * atomic_load(&record_count)) {
+        scan(rec);
+    }
+}
+
+static QNode* new_qnode(int value) {
+    QNode *node = (QNode*) malloc(sizeof(QNode));
+    node->value = value;
+    atomic_init(&node->next, NULL);
+    return node;
+}
+
+CQueue* cqueue_empty_list() {
+    CQueue *queue = (CQueue*) aligned_alloc(_Alignof(CQueue), sizeof(CQueue));
+    /* the head is always a dummy node; the elements follow it */
+    QNode *dummy = new_qnode(0);
+    atomic_init(&queue->head, dummy);
+    atomic_init(&queue->tail, dummy);
+    atomic_init(&queue->size, 0);
+    return queue;
+}
+
+void cqueue_delete_list(CQueue **queue) {
+    QNode *cur = atomic_load(&(*queue)->head);
+    while (cur) {
+        QNode *next = atomic_load(&cur->next);
+        free(cur);
+        cur = next;
+    }
+    free(*queue);
+    *queue = NULL;
+}
+
+int cqueue_is_empty(CQueue *queue) {
+    HazardRecord *rec = my_record();
+    QNode *head = protect(rec, 0, &queue->head);
+    int empty = atomic_load(&head->next) == NULL;
+    clear_hazards(rec);
+    return empty;
+}
+
+int cqueue_get_size(CQueue *queue) {
+    int size = atomic_load(&queue->size);
+    return size > 0 ? size : 0;
+}
+
+CQueue* cqueue_push_back(CQueue *queue, int value) {
+    HazardRecord *rec = my_record();
+    QNode *node = new_qnode(value);
+    while (1) {
+        QNode *tail = protect(rec, 0, &queue->tail);
+        QNode *next = atomic_load(&tail->next);
+        if (tail != atomic_load(&queue->tail)) {
+            continue;
+        }
+        if (next) {
+            /* another push linked its node but has not moved the tail yet */
+            atomic_compare_exchange_weak(&queue->tail, &tail, next);
+            continue;
+        }
+        QNode *expected = NULL;
+        if (atomic_compare_exchange_weak(&tail->next, &expected, node)) {
+            atomic_compare_exchange_strong(&queue->tail, &tail, node);
+            break;
+        }
+    }
+    clear_hazards(rec);
+    atomic_fetch_add_explicit(&queue->size, 1, memory_order_relaxed);
+    return queue;
+}
+
+int cqueue_pop(CQueue *queue, int *value) {
+    HazardRecord *rec = my_record();
+    QNode *head;
+    int found = 0;
+    while (1) {
+        head = protect(rec, 0, &queue->head);
+        QNode *tail = atomic_load(&queue->tail);
+        QNode *next = atomic_load(&head->next);
+        atomic_store(&rec->hazards[1], next);
+        if (head != atomic_load(&queue->head)) {
+            continue;
+        }
+        if (!next) {
+            break;
+        }
+        if (head == tail) {
+            /* the tail lags behind; move it before the head passes it */
+            atomic_compare_exchange_weak(&queue->tail, &tail, next);
+            continue;
+        }
+        int result = next->value;
+        if (atomic_compare_exchange_weak(&queue->head, &head, next)) {
+            *value = result;
+            found = 1;
+            break;
+        }
+    }
+    clear_hazards(rec);
+    if (found) {
+        /* the old dummy; next is the new one */
+        atomic_fetch_sub_explicit(&queue->size, 1, memory_order_relaxed);
+        retire(rec, head);
+    }
+    return found;
+}
+
+void cqueue_reclaim() {
+    scan(my_record());
+}
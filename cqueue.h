@@ -0,0 +1,40 @@
+#ifndef CQUEUE_H_
+#define CQUEUE_H_
+
+/* Concurrent Integer Queue
+
+    A lock-free FIFO list (Michael and Scott) for producer/consumer use:
+    any number of threads may call cqueue_push_back, cqueue_pop and
+    cqueue_is_empty at the same time without a lock. Removed nodes are
+    reclaimed with hazard pointers, so a node is freed only once no thread
+    can still read it.
+
+    There is no lock-free push at the front: a value put back at the head
+    would race with consumers, so the queue only supports adding at the
+    back. Creating and deleting the queue are not concurrent operations. */
+
+typedef struct CQueue CQueue;
+
+/* Returns an empty queue. */
+extern CQueue* cqueue_empty_list();
+
+/* Delete the queue and its remaining elements. No other thread may use it. */
+extern void cqueue_delete_list(CQueue**);
+
+/* Returns true if the queue contained no elements at some point during the call. */
+extern int cqueue_is_empty(CQueue*);
+
+/* Returns the number of elements, exact only when no other thread changes the queue. */
+extern int cqueue_get_size(CQueue*);
+
+/* [Mutator] Adds the value to the back of the queue. */
+extern CQueue* cqueue_push_back(CQueue*, int);
+
+/* [Mutator] Removes the value at the front of the queue and stores it into
+    the second argument. Returns false, leaving it unchanged, if the queue is empty. */
+extern int cqueue_pop(CQueue*, int*);
+
+/* Frees the removed nodes of the calling thread that no thread still reads. */
+extern void cqueue_reclaim();
+
+#endif
@@ -0,0 +1,812 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include "dlist.h"
+#include "iset.h"
+#include "icallback.h"
+
+static DNode* new_dnode(int value) {
+    DNode *node = (DNode*) malloc(sizeof(DNode));
+    node->value = value;
+    node->prev = NULL;
+    node->next = NULL;
+    return node;
+}
+
+/* Unlinks the node from the list and frees it. */
+static void unlink_dnode(DList *list, DNode *node) {
+    if (node->prev) {
+        node->prev->next = node->next;
+    } else {
+        list->first = node->next;
+    }
+    if (node->next) {
+        node->next->prev = node->prev;
+    } else {
+        list->last = node->prev;
+    }
+    list->size--;
+    free(node);
+}
+
+int dlist_is_empty(DList *list) {
+    return list->size == 0;
+}
+
+int dlist_is_not_empty(DList *list) {
+    return list->size != 0;
+}
+
+DList* dlist_empty_list() {
+    DList *list = (DList*) malloc(sizeof(DList));
+    list->first = NULL;
+    list->last = NULL;
+    list->size = 0;
+    return list;
+}
+
+DList* dlist_single_list_of(int value) {
+    return dlist_push_back(dlist_empty_list(), value);
+}
+
+DList* dlist_list_of(int count, ...) {
+    va_list items;
+    va_start(items, count);
+    DList *list = dlist_empty_list();
+    for (int i = 0; i < count; i++) {
+        dlist_push_back(list, va_arg(items, int));
+    }
+    va_end(items);
+    return list;
+}
+
+DList* dlist_range(int first, int last) {
+    return dlist_range_step(first, last, first < last ? 1 : -1);
+}
+
+DList* dlist_range_step(int first, int last, int step) {
+    DList *list = dlist_empty_list();
+    if (step > 0) {
+        for (int i = first; i <= last; i += step) {
+            dlist_push_back(list, i);
+        }
+    } else {
+        for (int i = first; i >= last; i += step) {
+            dlist_push_back(list, i);
+        }
+    }
+    return list;
+}
+
+DList* dlist_range_ex(int first, int last) {
+    return dlist_range_step_ex(first, last, first < last ? 1 : -1);
+}
+
+DList* dlist_range_step_ex(int first, int last, int step) {
+    DList *list = dlist_empty_list();
+    if (step > 0) {
+        for (int i = first; i < last; i += step) {
+            dlist_push_back(list, i);
+        }
+    } else {
+        for (int i = first; i > last; i += step) {
+            dlist_push_back(list, i);
+        }
+    }
+    return list;
+}
+
+static DList* generate_count(int start, const Callback *op, int count) {
+    DList *list = dlist_empty_list();
+    for (int cur = start, i = 0; i < count; cur = apply(op, cur), i++) {
+        dlist_push_back(list, cur);
+    }
+    return list;
+}
+
+DList* dlist_generate_n(int start, i_func op, int count) {
+    return generate_count(start, PLAIN(op), count);
+}
+
+DList* dlist_generate_n_ctx(int start, i_func_ctx op, int count, void *ctx) {
+    return generate_count(start, WITH_CTX(op, ctx), count);
+}
+
+static DList* generate_until(int start, const Callback *op, const Callback *cond) {
+    DList *list = dlist_empty_list();
+    for (int cur = start; apply(cond, cur); cur = apply(op, cur)) {
+        dlist_push_back(list, cur);
+    }
+    return list;
+}
+
+DList* dlist_generate_while(int start, i_func op, i_func cond) {
+    return generate_until(start, PLAIN(op), PLAIN(cond));
+}
+
+DList* dlist_generate_while_ctx(int start, i_func_ctx op, i_func_ctx cond, void *ctx) {
+    return generate_until(start, WITH_CTX(op, ctx), WITH_CTX(cond, ctx));
+}
+
+DList* dlist_repeat(int value, int count) {
+    DList *list = dlist_empty_list();
+    for (int i = 0; i < count; i++) {
+        dlist_push(list, value);
+    }
+    return list;
+}
+
+void dlist_delete_list(DList **list) {
+    DNode *node = (*list)->first;
+    while (node) {
+        DNode *next = node->next;
+        free(node);
+        node = next;
+    }
+    free(*list);
+    *list = NULL;
+}
+
+int dlist_equals(DList *fst, DList *snd) {
+    if (fst->size != snd->size) {
+        return 0;
+    }
+    for (DNode *c1 = fst->first, *c2 = snd->first; c1; c1 = c1->next, c2 = c2->next) {
+        if (c1->value != c2->value) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+int dlist_get_size(DList *list) {
+    return list->size;
+}
+
+DList* dlist_push(DList *list, int value) {
+    DNode *node = new_dnode(value);
+    if (dlist_is_empty(list)) {
+        list->last = node;
+    } else {
+        node->next = list->first;
+        list->first->prev = node;
+    }
+    list->first = node;
+    list->size++;
+    return list;
+}
+
+DList* dlist_push_back(DList *list, int value) {
+    DNode *node = new_dnode(value);
+    if (dlist_is_empty(list)) {
+        list->first = node;
+    } else {
+        node->prev = list->last;
+        list->last->next = node;
+    }
+    list->last = node;
+    list->size++;
+    return list;
+}
+
+DList* dlist_insert(DList *list, int pos, int value) {
+    if (pos == 0) {
+        return dlist_push(list, value);
+    } else if (pos == list->size) {
+        return dlist_push_back(list, value);
+    }
+    DNode *next = dlist_get_node(list, pos);
+    DNode *node = new_dnode(value);
+    node->prev = next->prev;
+    node->next = next;
+    next->prev->next = node;
+    next->prev = node;
+    list->size++;
+    return list;
+}
+
+int dlist_pop(DList *list) {
+    int value = list->first->value;
+    dlist_drop(list);
+    return value;
+}
+
+int dlist_pop_back(DList *list) {
+    int value = list->last->value;
+    dlist_drop_back(list);
+    return value;
+}
+
+DList* dlist_delete(DList *list, int pos) {
+    unlink_dnode(list, dlist_get_node(list, pos));
+    return list;
+}
+
+DList* dlist_delete_item(DList *list, int value) {
+    DNode *cur = list->first;
+    while (cur) {
+        DNode *next = cur->next;
+        if (cur->value == value) {
+            unlink_dnode(list, cur);
+        }
+        cur = next;
+    }
+    return list;
+}
+
+DList* dlist_drop(DList *list) {
+    unlink_dnode(list, list->first);
+    return list;
+}
+
+DList* dlist_drop_back(DList *list) {
+    unlink_dnode(list, list->last);
+    return list;
+}
+
+DList* dlist_drop_n(DList *list, int n) {
+    for (int i = 0; i < n && list->first; i++) {
+        dlist_drop(list);
+    }
+    return list;
+}
+
+DList* dlist_drop_back_n(DList *list, int n) {
+    for (int i = 0; i < n && list->last; i++) {
+        dlist_drop_back(list);
+    }
+    return list;
+}
+
+static DList* drop_front_where(DList *list, const Callback *pred) {
+    while (list->first && apply(pred, list->first->value)) {
+        dlist_drop(list);
+    }
+    return list;
+}
+
+DList* dlist_drop_while(DList *list, i_func pred) {
+    return drop_front_where(list, PLAIN(pred));
+}
+
+DList* dlist_drop_while_ctx(DList *list, i_func_ctx pred, void *ctx) {
+    return drop_front_where(list, WITH_CTX(pred, ctx));
+}
+
+static DList* drop_back_where(DList *list, const Callback *pred) {
+    while (list->last && apply(pred, list->last->value)) {
+        dlist_drop_back(list);
+    }
+    return list;
+}
+
+DList* dlist_drop_back_while(DList *list, i_func pred) {
+    return drop_back_where(list, PLAIN(pred));
+}
+
+DList* dlist_drop_back_while_ctx(DList *list, i_func_ctx pred, void *ctx) {
+    return drop_back_where(list, WITH_CTX(pred, ctx));
+}
+
+DList* dlist_update(DList *list, int pos, int value) {
+    dlist_get_node(list, pos)->value = value;
+    return list;
+}
+
+DList* dlist_sublist(DList *list, int start, int end) {
+    dlist_drop_back_n(list, list->size - end);
+    return dlist_drop_n(list, start);
+}
+
+DList* dlist_from_array(int size, int *arr) {
+    DList *result = dlist_empty_list();
+    if (arr == NULL || size == 0) {
+        return result;
+    }
+    for (int i = 0; i < size; i++) {
+        dlist_push_back(result, arr[i]);
+    }
+    return result;
+}
+
+int* dlist_to_array(DList *list) {
+    int ind = 0;
+    int *arr = (int*) malloc(list->size * sizeof(int));
+    for (DNode *cur = list->first; cur; cur = cur->next) {
+        arr[ind++] = cur->value;
+    }
+    return arr;
+}
+
+void dlist_foreach(DList *list, void (*op)(int)) {
+    for (DNode *cur = list->first; cur; cur = cur->next) {
+        op(cur->value);
+    }
+}
+
+void dlist_foreach_ctx(DList *list, void (*op)(int, void*), void *ctx) {
+    for (DNode *cur = list->first; cur; cur = cur->next) {
+        op(cur->value, ctx);
+    }
+}
+
+void dlist_foreach_right(DList *list, void (*op)(int)) {
+    for (DNode *cur = list->last; cur; cur = cur->prev) {
+        op(cur->value);
+    }
+}
+
+void dlist_foreach_right_ctx(DList *list, void (*op)(int, void*), void *ctx) {
+    for (DNode *cur = list->last; cur; cur = cur->prev) {
+        op(cur->value, ctx);
+    }
+}
+
+void dlist_print_list(DList *list) {
+    printf("DList %p : [", list);
+    for (DNode *cur = list->first; cur; cur = cur->next) {
+        printf(cur->next ? "%d, " : "%d", cur->value);
+    }
+    printf("]\n");
+}
+
+DList* dlist_reverse(DList *list) {
+    DList *result = dlist_empty_list();
+    for (DNode *cur = list->last; cur; cur = cur->prev) {
+        dlist_push_back(result, cur->value);
+    }
+    return result;
+}
+
+DList* dlist_reverse_in_place(DList *list) {
+    DNode *cur = list->first;
+    while (cur) {
+        DNode *next = cur->next;
+        cur->next = cur->prev;
+        cur->prev = next;
+        cur = next;
+    }
+    DNode *first = list->first;
+    list->first = list->last;
+    list->last = first;
+    return list;
+}
+
+DNode* dlist_get_first_node(DList *list) {
+    return list->first;
+}
+
+DNode* dlist_get_last_node(DList *list) {
+    return list->last;
+}
+
+DNode* dlist_get_node(DList *list, int index) {
+    DNode *cur;
+    if (index < list->size / 2) {
+        cur = list->first;
+        for (int i = 0; cur && i < index; cur = cur->next, i++);
+    } else {
+        cur = list->last;
+        for (int i = list->size - 1; cur && i > index; cur = cur->prev, i--);
+    }
+    return cur;
+}
+
+int dlist_get_first(DList *list) {
+    return list->first->value;
+}
+
+int dlist_get_last(DList *list) {
+    return list->last->value;
+}
+
+int dlist_get(DList *list, int index) {
+    return dlist_get_node(list, index)->value;
+}
+
+int dlist_find(DList *list, i_func pred) {
+    return dlist_find_or(list, pred, 0);
+}
+
+int dlist_find_not(DList *list, i_func pred) {
+    return dlist_find_not_or(list, pred, 0);
+}
+
+int dlist_find_ctx(DList *list, i_func_ctx pred, void *ctx) {
+    return dlist_find_or_ctx(list, pred, 0, ctx);
+}
+
+int dlist_find_not_ctx(DList *list, i_func_ctx pred, void *ctx) {
+    return dlist_find_not_or_ctx(list, pred, 0, ctx);
+}
+
+/* Returns the first node for which the predicate is true (or false if wanted is),
+    or NULL. */
+static DNode* find_where(DList *list, const Callback *pred, int wanted) {
+    for (DNode *cur = list->first; cur; cur = cur->next) {
+        if (!apply(pred, cur->value) == !wanted) {
+            return cur;
+        }
+    }
+    return NULL;
+}
+
+int dlist_find_or(DList *list, i_func pred, int default_value) {
+    DNode *node = find_where(list, PLAIN(pred), 1);
+    return node ? node->value : default_value;
+}
+
+int dlist_find_not_or(DList *list, i_func pred, int default_value) {
+    DNode *node = find_where(list, PLAIN(pred), 0);
+    return node ? node->value : default_value;
+}
+
+int dlist_find_or_ctx(DList *list, i_func_ctx pred, int default_value, void *ctx) {
+    DNode *node = find_where(list, WITH_CTX(pred, ctx), 1);
+    return node ? node->value : default_value;
+}
+
+int dlist_find_not_or_ctx(DList *list, i_func_ctx pred, int default_value, void *ctx) {
+    DNode *node = find_where(list, WITH_CTX(pred, ctx), 0);
+    return node ? node->value : default_value;
+}
+
+int dlist_index_of(DList *list, int item) {
+    int index = 0;
+    for (DNode *cur = list->first; cur; cur = cur->next) {
+        if (item == cur->value) {
+            return index;
+        }
+        index++;
+    }
+    return -1;
+}
+
+int dlist_last_index_of(DList *list, int item) {
+    int index = list->size - 1;
+    for (DNode *cur = list->last; cur; cur = cur->prev) {
+        if (item == cur->value) {
+            return index;
+        }
+        index--;
+    }
+    return -1;
+}
+
+DList* dlist_clone(DList *list) {
+    DList *result = dlist_empty_list();
+    for (DNode *cur = list->first; cur; cur = cur->next) {
+        dlist_push_back(result, cur->value);
+    }
+    return result;
+}
+
+static DList* map_with(DList *list, const Callback *op) {
+    for (DNode *cur = list->first; cur; cur = cur->next) {
+        cur->value = apply(op, cur->value);
+    }
+    return list;
+}
+
+DList* dlist_map(DList *list, i_func op) {
+    return map_with(list, PLAIN(op));
+}
+
+DList* dlist_map_ctx(DList *list, i_func_ctx op, void *ctx) {
+    return map_with(list, WITH_CTX(op, ctx));
+}
+
+/* Returns a new list of the elements for which the predicate is true (or false if keep is). */
+static DList* filter_where(DList *list, const Callback *pred, int keep) {
+    DList *result = dlist_empty_list();
+    for (DNode *cur = list->first; cur; cur = cur->next) {
+        if (!apply(pred, cur->value) == !keep) {
+            dlist_push_back(result, cur->value);
+        }
+    }
+    return result;
+}
+
+DList* dlist_filter(DList *list, i_func pred) {
+    return filter_where(list, PLAIN(pred), 1);
+}
+
+DList* dlist_filter_not(DList *list, i_func pred) {
+    return filter_where(list, PLAIN(pred), 0);
+}
+
+DList* dlist_filter_ctx(DList *list, i_func_ctx pred, void *ctx) {
+    return filter_where(list, WITH_CTX(pred, ctx), 1);
+}
+
+DList* dlist_filter_not_ctx(DList *list, i_func_ctx pred, void *ctx) {
+    return filter_where(list, WITH_CTX(pred, ctx), 0);
+}
+
+DList* dlist_add_all(DList *list, DList *elems) {
+    int n = elems->size;
+    for (DNode *cur = elems->first; n > 0; cur = cur->next, n--) {
+        dlist_push_back(list, cur->value);
+    }
+    return list;
+}
+
+int dlist_contains(DList *list, int value) {
+    for (DNode *cur = list->first; cur; cur = cur->next) {
+        if (cur->value == value) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/* Applies the operator to the accumulator and each element from the node on, going left to right. */
+static int fold_from(int init, DNode *first, const BiCallback *op) {
+    int acc = init;
+    for (DNode *cur = first; cur; cur = cur->next) {
+        acc = combine(op, acc, cur->value);
+    }
+    return acc;
+}
+
+/* Applies the operator to each element from the node back and the accumulator,
+    going right to left. */
+static int fold_back(int init, DNode *last, const BiCallback *op) {
+    int acc = init;
+    for (DNode *cur = last; cur; cur = cur->prev) {
+        acc = combine(op, cur->value, acc);
+    }
+    return acc;
+}
+
+int dlist_fold_left(int init, DList *list, i_bifunc op) {
+    return fold_from(init, list->first, PLAIN2(op));
+}
+
+int dlist_reduce_left(DList *list, i_bifunc op) {
+    return dlist_is_empty(list) ? 0 : fold_from(list->first->value, list->first->next, PLAIN2(op));
+}
+
+int dlist_fold_right(int init, DList *list, i_bifunc op) {
+    return fold_back(init, list->last, PLAIN2(op));
+}
+
+int dlist_reduce_right(DList *list, i_bifunc op) {
+    return dlist_is_empty(list) ? 0 : fold_back(list->last->value, list->last->prev, PLAIN2(op));
+}
+
+int dlist_fold_left_ctx(int init, DList *list, i_bifunc_ctx op, void *ctx) {
+    return fold_from(init, list->first, WITH_CTX2(op, ctx));
+}
+
+int dlist_reduce_left_ctx(DList *list, i_bifunc_ctx op, void *ctx) {
+    return dlist_is_empty(list) ? 0 : fold_from(list->first->value, list->first->next, WITH_CTX2(op, ctx));
+}
+
+int dlist_fold_right_ctx(int init, DList *list, i_bifunc_ctx op, void *ctx) {
+    return fold_back(init, list->last, WITH_CTX2(op, ctx));
+}
+
+int dlist_reduce_right_ctx(DList *list, i_bifunc_ctx op, void *ctx) {
+    return dlist_is_empty(list) ? 0 : fold_back(list->last->value, list->last->prev, WITH_CTX2(op, ctx));
+}
+
+DList* dlist_take(DList *list, int n) {
+    DList *result = dlist_empty_list();
+    DNode *cur = list->first;
+    for (int i = 0; i < n && cur; i++, cur = cur->next) {
+        dlist_push_back(result, cur->value);
+    }
+    return result;
+}
+
+static DList* take_where(DList *list, const Callback *pred) {
+    DList *result = dlist_empty_list();
+    for (DNode *cur = list->first; cur && apply(pred, cur->value); cur = cur->next) {
+        dlist_push_back(result, cur->value);
+    }
+    return result;
+}
+
+DList* dlist_take_while(DList *list, i_func pred) {
+    return take_where(list, PLAIN(pred));
+}
+
+DList* dlist_take_while_ctx(DList *list, i_func_ctx pred, void *ctx) {
+    return take_where(list, WITH_CTX(pred, ctx));
+}
+
+DList* dlist_take_right(DList *list, int n) {
+    DList *result = dlist_empty_list();
+    DNode *cur = list->last;
+    for (int i = 0; i < n && cur; i++, cur = cur->prev) {
+        dlist_push(result, cur->value);
+    }
+    return result;
+}
+
+static DList* take_right_where(DList *list, const Callback *pred) {
+    DList *result = dlist_empty_list();
+    for (DNode *cur = list->last; cur && apply(pred, cur->value); cur = cur->prev) {
+        dlist_push(result, cur->value);
+    }
+    return result;
+}
+
+DList* dlist_take_right_while(DList *list, i_func pred) {
+    return take_right_where(list, PLAIN(pred));
+}
+
+DList* dlist_take_right_while_ctx(DList *list, i_func_ctx pred, void *ctx) {
+    return take_right_where(list, WITH_CTX(pred, ctx));
+}
+
+DList* dlist_slice(DList *list, int start, int end) {
+    DList *result = dlist_empty_list();
+    if (start < 0) {
+        start = 0;
+    }
+    if (end > list->size - 1) {
+        end = list->size - 1;
+    }
+    if (start > end) {
+        return result;
+    }
+    DNode *cur = dlist_get_node(list, start);
+    for (int i = start; i <= end; i++, cur = cur->next) {
+        dlist_push_back(result, cur->value);
+    }
+    return result;
+}
+
+static int count_where(DList *list, const Callback *pred) {
+    int count = 0;
+    for (DNode *cur = list->first; cur; cur = cur->next) {
+        if (apply(pred, cur->value)) {
+            count++;
+        }
+    }
+    return count;
+}
+
+int dlist_forall(DList *list, i_func pred) {
+    return find_where(list, PLAIN(pred), 0) == NULL;
+}
+
+int dlist_exists(DList *list, i_func pred) {
+    return find_where(list, PLAIN(pred), 1) != NULL;
+}
+
+int dlist_count(DList *list, i_func pred) {
+    return count_where(list, PLAIN(pred));
+}
+
+int dlist_forall_ctx(DList *list, i_func_ctx pred, void *ctx) {
+    return find_where(list, WITH_CTX(pred, ctx), 0) == NULL;
+}
+
+int dlist_exists_ctx(DList *list, i_func_ctx pred, void *ctx) {
+    return find_where(list, WITH_CTX(pred, ctx), 1) != NULL;
+}
+
+int dlist_count_ctx(DList *list, i_func_ctx pred, void *ctx) {
+    return count_where(list, WITH_CTX(pred, ctx));
+}
+
+DList* dlist_unique(DList *list) {
+    DList *result = dlist_empty_list();
+    ISet *seen = iset_empty(list->size);
+    for (DNode *cur = list->first; cur; cur = cur->next) {
+        if (iset_add(seen, cur->value)) {
+            dlist_push_back(result, cur->value);
+        }
+    }
+    iset_delete(&seen);
+    return result;
+}
+
+DList* dlist_distinct(DList *list) {
+    ISet *seen = iset_empty(list->size);
+    DNode *cur = list->first;
+    while (cur) {
+        DNode *next = cur->next;
+        if (!iset_add(seen, cur->value)) {
+            unlink_dnode(list, cur);
+        }
+        cur = next;
+    }
+    iset_delete(&seen);
+    return list;
+}
+
+DList* dlist_swap(DList *list, int i, int j) {
+    DNode *ni = dlist_get_node(list, i);
+    DNode *nj = dlist_get_node(list, j);
+    int vi = ni->value;
+    ni->value = nj->value;
+    nj->value = vi;
+    return list;
+}
+
+int dlist_is_prefix(DList *list, DList *prefix) {
+    if (list->size < prefix->size) {
+        return 0;
+    }
+    for (DNode *l = list->first, *p = prefix->first; p; l = l->next, p = p->next) {
+        if (l->value != p->value) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+int dlist_is_suffix(DList *list, DList *suffix) {
+    if (list->size < suffix->size) {
+        return 0;
+    }
+    for (DNode *l = list->last, *s = suffix->last; s; l = l->prev, s = s->prev) {
+        if (l->value != s->value) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+int dlist_is_sublist(DList *list, DList *sublist) {
+    int tries = list->size - sublist->size + 1;
+    for (DNode *start = list->first; tries > 0; start = start->next, tries--) {
+        DNode *l = start, *s = sublist->first;
+        for (; s && l->value == s->value; l = l->next, s = s->next);
+        if (!s) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+DList* dlist_intersperse(DList *list, int value) {
+    DList *result = dlist_empty_list();
+    for (DNode *cur = list->first; cur; cur = cur->next) {
+        dlist_push_back(result, cur->value);
+        if (cur->next) {
+            dlist_push_back(result, value);
+        }
+    }
+    return result;
+}
+
+int dlist_max(DList *list) {
+    int max = list->first->value;
+    for (DNode *cur = list->first; cur; cur = cur->next) {
+        if (cur->value > max) {
+            max = cur->value;
+        }
+    }
+    return max;
+}
+
+int dlist_min(DList *list) {
+    int min = list->first->value;
+    for (DNode *cur = list->first; cur; cur = cur->next) {
+        if (cur->value < min) {
+            min = cur->value;
+        }
+    }
+    return min;
+}
+
+int dlist_sum(DList *list) {
+    int sum = 0;
+    for (DNode *cur = list->first; cur; cur = cur->next) {
+        sum += cur->value;
+    }
+    return sum;
+}
+
+long long dlist_sum64(DList *list) {
+    long long sum = 0;
+    for (DNode *cur = list->first; cur; cur = cur->next) {
+        sum += cur->value;
+    }
+    return sum;
+}
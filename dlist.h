@@ -0,0 +1,318 @@
+#ifndef DLIST_H_
+#define DLIST_H_
+
+#include "ilist.h"
+
+/* Doubly Linked Integer List */
+
+typedef struct DNode {
+    int value;
+    struct DNode *prev;
+    struct DNode *next;
+} DNode;
+
+typedef struct {
+    DNode *first;
+    DNode *last;
+    int size;
+} DList;
+
+/* Returns true if this list contains some elements. */
+extern int dlist_is_empty(DList*);
+
+/* Returns true if this list contains no elements. */
+extern int dlist_is_not_empty(DList*);
+
+/* Returns a empty list. */
+extern DList* dlist_empty_list();
+
+/* Returns a list containing only the specified object. */
+extern DList* dlist_single_list_of(int);
+
+/* Returns a list containing an arbitrary number of elements. */
+extern DList* dlist_list_of(int, ...);
+
+/* Returns a sequential ordered DList from start (inclusive)
+    to end (inclusive) by an incremental step of 1 (or -1). */
+extern DList* dlist_range(int, int);
+
+/* Returns a sequential ordered DList from start (inclusive)
+    to end (inclusive) by a specified step. */
+extern DList* dlist_range_step(int, int, int);
+
+/* Returns a sequential ordered DList from start (inclusive)
+    to end (exclusive) by an incremental step of 1 (or -1). */
+extern DList* dlist_range_ex(int, int);
+
+/* Returns a sequential ordered DList from start (inclusive)
+    to end (exclusive) by a specified step. */
+extern DList* dlist_range_step_ex(int, int, int);
+
+/* Returns a list of n elements produced by iterative application
+    of a function to an initial element. */
+extern DList* dlist_generate_n(int, i_func, int);
+
+/* dlist_generate_n with a function that receives the context. */
+extern DList* dlist_generate_n_ctx(int, i_func_ctx, int, void*);
+
+/* Returns a list produced by iterative application of a function
+    to an initial element while the condition is satisfied. */
+extern DList* dlist_generate_while(int, i_func, i_func);
+
+/* dlist_generate_while with a function and a condition that receive the context. */
+extern DList* dlist_generate_while_ctx(int, i_func_ctx, i_func_ctx, void*);
+
+/* Returns a list consisting of n copies of the specified object. */
+extern DList* dlist_repeat(int, int);
+
+/* Delete the list. */
+extern void dlist_delete_list(DList**);
+
+/* Returns true if the arguments are equal to each other and false otherwise. */
+extern int dlist_equals(DList*, DList*);
+
+/* Returns a size of the list. */
+extern int dlist_get_size(DList*);
+
+/* [Mutator] Pushes an element onto the stack represented by this list.
+    (Inserts the specified element at the beginning of this list.) */
+extern DList* dlist_push(DList*, int);
+
+/* [Mutator] Appends the specified element to the end of this list. */
+extern DList* dlist_push_back(DList*, int);
+
+/* [Mutator] Inserts the specified element at the position of this list. */
+extern DList* dlist_insert(DList*, int, int);
+
+/* [Mutator] Pops an element from the stack represented by this list.
+    (Removes and returns the first element from this list.) */
+extern int dlist_pop(DList*);
+
+/* [Mutator] Removes and returns the last element from this list. */
+extern int dlist_pop_back(DList*);
+
+/* [Mutator] Removes the element at the specified position in this list. */
+extern DList* dlist_delete(DList*, int);
+
+/* [Mutator] Removes all occurrences of the specified element from this list. */
+extern DList* dlist_delete_item(DList*, int);
+
+/* [Mutator] Removes the first element from this list. */
+extern DList* dlist_drop(DList*);
+
+/* [Mutator] Removes the last element from this list. */
+extern DList* dlist_drop_back(DList*);
+
+/* [Mutator] Removes first n elements from this list. */
+extern DList* dlist_drop_n(DList*, int);
+
+/* [Mutator] Removes last n elements from this list. */
+extern DList* dlist_drop_back_n(DList*, int);
+
+/* [Mutator] Removes first elements from this list while the condition is satisfied. */
+extern DList* dlist_drop_while(DList*, i_func);
+
+/* [Mutator] dlist_drop_while with a predicate that receives the context. */
+extern DList* dlist_drop_while_ctx(DList*, i_func_ctx, void*);
+
+/* [Mutator] Removes last elements from this list while the condition is satisfied. */
+extern DList* dlist_drop_back_while(DList*, i_func);
+
+/* [Mutator] dlist_drop_back_while with a predicate that receives the context. */
+extern DList* dlist_drop_back_while_ctx(DList*, i_func_ctx, void*);
+
+/* [Mutator] Replaces the element at the specified position in this list
+    with the specified value. */
+extern DList* dlist_update(DList*, int, int);
+
+/* [Mutator] Returns sublist. */
+extern DList* dlist_sublist(DList*, int, int);
+
+/* Returns a list containing elements of the array. */
+extern DList* dlist_from_array(int, int*);
+
+/* Returns an array containing elements of the list. */
+extern int* dlist_to_array(DList*);
+
+/* Performs the given action for each element of the list. */
+extern void dlist_foreach(DList*, void (*op)(int));
+
+/* dlist_foreach with an action that receives the context. */
+extern void dlist_foreach_ctx(DList*, void (*op)(int, void*), void*);
+
+/* Performs the given action for each element of the list, going right to left. */
+extern void dlist_foreach_right(DList*, void (*op)(int));
+
+/* dlist_foreach_right with an action that receives the context. */
+extern void dlist_foreach_right_ctx(DList*, void (*op)(int, void*), void*);
+
+/* Print the list. */
+extern void dlist_print_list(DList*);
+
+/* Returns new list with elements in reversed order. */
+extern DList* dlist_reverse(DList*);
+
+/* [Mutator] Reverses the order of the elements of this list. */
+extern DList* dlist_reverse_in_place(DList*);
+
+/* Returns a first node of the list. */
+extern DNode* dlist_get_first_node(DList*);
+
+/* Returns a last node of the list. */
+extern DNode* dlist_get_last_node(DList*);
+
+/* Returns a node of the list at the specified position. */
+extern DNode* dlist_get_node(DList*, int);
+
+/* Returns a first value of the list. */
+extern int dlist_get_first(DList*);
+
+/* Returns a last value of the list. */
+extern int dlist_get_last(DList*);
+
+/* Returns a value of the list at the specified position. */
+extern int dlist_get(DList*, int);
+
+/* Finds the first element of the list a predicate. */
+extern int dlist_find(DList*, i_func);
+
+/* Finds the first element of the list a negative predicate. */
+extern int dlist_find_not(DList*, i_func);
+
+/* Finds the first element of the list a predicate or returns default value. */
+extern int dlist_find_or(DList*, i_func, int);
+
+/* Finds the first element of the list a negative predicate or returns default value. */
+extern int dlist_find_not_or(DList*, i_func, int);
+
+/* dlist_find, dlist_find_not, dlist_find_or and dlist_find_not_or with a predicate that receives
+    the context. */
+extern int dlist_find_ctx(DList*, i_func_ctx, void*);
+extern int dlist_find_not_ctx(DList*, i_func_ctx, void*);
+extern int dlist_find_or_ctx(DList*, i_func_ctx, int, void*);
+extern int dlist_find_not_or_ctx(DList*, i_func_ctx, int, void*);
+
+/* Returns the index of the first occurrence of the specified element in this list,
+    or -1 if this list does not contain the element. */
+extern int dlist_index_of(DList*, int);
+
+/* Returns the index of the last occurrence of the specified element in this list,
+    or -1 if this list does not contain the element. */
+extern int dlist_last_index_of(DList*, int);
+
+/* Returns a copy of this. */
+extern DList* dlist_clone(DList*);
+
+/* Returns a list consisting of the results of applying the given function
+    to the elements of this list. */
+extern DList* dlist_map(DList*, i_func);
+
+/* dlist_map with a function that receives the context. */
+extern DList* dlist_map_ctx(DList*, i_func_ctx, void*);
+
+/* Returns a list consisting of the elements of this list that match the given predicate. */
+extern DList* dlist_filter(DList*, i_func);
+
+/* Returns a list consisting of the elements of this list that
+    match the negation given predicate. */
+extern DList* dlist_filter_not(DList*, i_func);
+
+/* dlist_filter and dlist_filter_not with a predicate that receives the context. */
+extern DList* dlist_filter_ctx(DList*, i_func_ctx, void*);
+extern DList* dlist_filter_not_ctx(DList*, i_func_ctx, void*);
+
+/* [Mutator] Appends all of the elements in the second collection to the end of first list. */
+extern DList* dlist_add_all(DList*, DList*);
+
+/* Returns true if the list contains the specified element. */
+extern int dlist_contains(DList*, int);
+
+/* Applies a binary operator to a start value and all elements of the list, going left to right. */
+extern int dlist_fold_left(int, DList*, i_bifunc);
+
+/* Applies a binary operator to all elements of the list, going left to right. */
+extern int dlist_reduce_left(DList*, i_bifunc);
+
+/* Applies a binary operator to all elements of the list and a start value, going right to left. */
+extern int dlist_fold_right(int, DList*, i_bifunc);
+
+/* Applies a binary operator to all elements of the list, going right to left. */
+extern int dlist_reduce_right(DList*, i_bifunc);
+
+/* The folds and reductions with an operator that receives the context. */
+extern int dlist_fold_left_ctx(int, DList*, i_bifunc_ctx, void*);
+extern int dlist_reduce_left_ctx(DList*, i_bifunc_ctx, void*);
+extern int dlist_fold_right_ctx(int, DList*, i_bifunc_ctx, void*);
+extern int dlist_reduce_right_ctx(DList*, i_bifunc_ctx, void*);
+
+/* Selects first n elements. */
+extern DList* dlist_take(DList*, int);
+
+/* Takes longest prefix of elements that satisfy a predicate. */
+extern DList* dlist_take_while(DList*, i_func);
+
+/* dlist_take_while with a predicate that receives the context. */
+extern DList* dlist_take_while_ctx(DList*, i_func_ctx, void*);
+
+/* Selects last n elements. */
+extern DList* dlist_take_right(DList*, int);
+
+/* Takes longest suffix of elements that satisfy a predicate. */
+extern DList* dlist_take_right_while(DList*, i_func);
+
+/* dlist_take_right_while with a predicate that receives the context. */
+extern DList* dlist_take_right_while_ctx(DList*, i_func_ctx, void*);
+
+/* Returns a list containing the elements greater than or equal to index from extending up
+    to index until of the list. */
+extern DList* dlist_slice(DList*, int, int);
+
+/* Tests whether a predicate holds for all elements of the list. */
+extern int dlist_forall(DList*, i_func);
+
+/* Tests whether a predicate holds for at least one element of the list. */
+extern int dlist_exists(DList*, i_func);
+
+/* Counts the number of elements in the list which satisfy a predicate. */
+extern int dlist_count(DList*, i_func);
+
+/* dlist_forall, dlist_exists and dlist_count with a predicate that receives the context. */
+extern int dlist_forall_ctx(DList*, i_func_ctx, void*);
+extern int dlist_exists_ctx(DList*, i_func_ctx, void*);
+extern int dlist_count_ctx(DList*, i_func_ctx, void*);
+
+/* Builds a new list from the list without any duplicate elements. */
+extern DList* dlist_unique(DList*);
+
+/* [Mutator] Returns a list consisting only of the distinct elements (according to ==). */
+extern DList* dlist_distinct(DList*);
+
+/* [Mutator] Swap values of two elements in the list. */
+extern DList* dlist_swap(DList*, int, int);
+
+/* Returns true iff the first list is a prefix of the second. */
+extern int dlist_is_prefix(DList*, DList*);
+
+/* Returns true iff the first list is a suffix of the second. */
+extern int dlist_is_suffix(DList*, DList*);
+
+/* Returns true iff the first list is a sublist of the second. */
+extern int dlist_is_sublist(DList*, DList*);
+
+/* Returns a new list containing elements that `interspersed`
+    by the element between the elements of the list. */
+extern DList* dlist_intersperse(DList*, int);
+
+/* Finds the largest element. */
+extern int dlist_max(DList*);
+
+/* Finds the smallest element. */
+extern int dlist_min(DList*);
+
+/* Sums up the elements of the list. */
+extern int dlist_sum(DList*);
+
+/* Sums up the elements of the list into a 64-bit accumulator. */
+extern long long dlist_sum64(DList*);
+
+#endif
@@ -0,0 +1,37 @@
+#ifndef ICALLBACK_H_
+#define ICALLBACK_H_
+
+#include "ilist.h"
+
+/* Callbacks with or without context
+
+    A callback holds either a plain function or a function that receives a
+    context, so that each function of a list type and its _ctx variant share
+    one implementation. For use inside the library. */
+
+typedef struct {
+    i_func plain;
+    i_func_ctx with_ctx;
+    void *ctx;
+} Callback;
+
+typedef struct {
+    i_bifunc plain;
+    i_bifunc_ctx with_ctx;
+    void *ctx;
+} BiCallback;
+
+#define PLAIN(fn) (&(Callback) { fn, NULL, NULL })
+#define WITH_CTX(fn, ctx) (&(Callback) { NULL, fn, ctx })
+#define PLAIN2(fn) (&(BiCallback) { fn, NULL, NULL })
+#define WITH_CTX2(fn, ctx) (&(BiCallback) { NULL, fn, ctx })
+
+static inline int apply(const Callback *fn, int x) {
+    return fn->plain ? fn->plain(x) : fn->with_ctx(x, fn->ctx);
+}
+
+static inline int combine(const BiCallback *fn, int x, int y) {
+    return fn->plain ? fn->plain(x, y) : fn->with_ctx(x, y, fn->ctx);
+}
+
+#endif
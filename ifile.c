@@ -0,0 +1,404 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "ifile.h"
+#include "ireduce.h"
+
+#define FORMAT_VERSION 1
+
+/* Elements buffered between the caller and stdio. */
+#define BUFFER_SIZE 4096
+
+static const char MAGIC[4] = { 'I', 'L', 'S', 'T' };
+
+typedef struct {
+    unsigned long long count;
+    int min;
+    int max;
+    unsigned a;
+    unsigned b;
+} Summary;
+
+struct IWriter {
+    FILE *file;
+    Summary summary;
+    int failed;
+    int used;
+    unsigned buffer[BUFFER_SIZE];
+};
+
+struct IReader {
+    FILE *file;
+    Summary summary;
+    int size;
+    int read;
+    int failed;
+    int used;
+    int available;
+    unsigned long long checksum;
+    unsigned buffer[BUFFER_SIZE];
+};
+
+static int is_little_endian() {
+    const unsigned one = 1;
+    return *(const unsigned char*) &one == 1;
+}
+
+static unsigned swap_bytes(unsigned x) {
+    return (x >> 24) | ((x >> 8) & 0xFF00u) | ((x << 8) & 0xFF0000u) | (x << 24);
+}
+
+/* Converts elements between host and little-endian order, in place. */
+static void to_little_endian(unsigned *values, int count) {
+    if (!is_little_endian()) {
+        for (int i = 0; i < count; i++) {
+            values[i] = swap_bytes(values[i]);
+        }
+    }
+}
+
+static void put_u32(unsigned char *bytes, unsigned value) {
+    for (int i = 0; i < 4; i++) {
+        bytes[i] = (unsigned char) (value >> (8 * i));
+    }
+}
+
+static unsigned get_u32(const unsigned char *bytes) {
+    unsigned value = 0;
+    for (int i = 0; i < 4; i++) {
+        value |= (unsigned) bytes[i] << (8 * i);
+    }
+    return value;
+}
+
+static void put_u64(unsigned char *bytes, unsigned long long value) {
+    put_u32(bytes, (unsigned) value);
+    put_u32(bytes + 4, (unsigned) (value >> 32));
+}
+
+static unsigned long long get_u64(const unsigned char *bytes) {
+    return get_u32(bytes) | (unsigned long long) get_u32(bytes + 4) << 32;
+}
+
+static void summary_init(Summary *summary) {
+    summary->count = 0;
+    summary->min = INT_MAX;
+    summary->max = INT_MIN;
+    summary->a = 0;
+    summary->b = 0;
+}
+
+static void summary_add(Summary *summary, const int *values, int count) {
+    unsigned a = summary->a;
+    unsigned b = summary->b;
+    for (int i = 0; i < count; i++) {
+        a += (unsigned) values[i];
+        b += a;
+        if (values[i] < summary->min) {
+            summary->min = values[i];
+        }
+        if (values[i] > summary->max) {
+            summary->max = values[i];
+        }
+    }
+    summary->a = a;
+    summary->b = b;
+    summary->count += count;
+}
+
+static unsigned long long summary_checksum(Summary *summary) {
+    return (unsigned long long) summary->b << 32 | summary->a;
+}
+
+static void encode_header(unsigned char *header, Summary *summary) {
+    memcpy(header, MAGIC, 4);
+    put_u32(header + 4, FORMAT_VERSION);
+    put_u64(header + 8, summary->count);
+    put_u32(header + 16, (unsigned) summary->min);
+    put_u32(header + 20, (unsigned) summary->max);
+    put_u64(header + 24, summary_checksum(summary));
+}
+
+/* Decodes the header into the summary and checksum. Returns false if it is not a list file. */
+static int decode_header(const unsigned char *header, Summary *summary, unsigned long long *checksum) {
+    if (memcmp(header, MAGIC, 4) != 0 || get_u32(header + 4) != FORMAT_VERSION) {
+        return 0;
+    }
+    summary->count = get_u64(header + 8);
+    summary->min = (int) get_u32(header + 16);
+    summary->max = (int) get_u32(header + 20);
+    *checksum = get_u64(header + 24);
+    return summary->count <= INT_MAX;
+}
+
+int save_list(IList *list, const char *path) {
+    IWriter *writer = open_writer(path);
+    if (!writer) {
+        return -1;
+    }
+    writer_put_list(writer, list);
+    return close_writer(&writer);
+}
+
+IList* load_list(const char *path) {
+    IReader *reader = open_reader(path);
+    if (!reader) {
+        return NULL;
+    }
+    IList *list = empty_list();
+    int value;
+    while (reader_next(reader, &value)) {
+        push_back(list, value);
+    }
+    if (close_reader(&reader) != 0) {
+        delete_list(&list);
+        return NULL;
+    }
+    return list;
+}
+
+static void flush(IWriter *writer) {
+    summary_add(&writer->summary, (int*) writer->buffer, writer->used);
+    to_little_endian(writer->buffer, writer->used);
+    if (fwrite(writer->buffer, sizeof(unsigned), writer->used, writer->file) != (size_t) writer->used) {
+        writer->failed = 1;
+    }
+    writer->used = 0;
+}
+
+IWriter* open_writer(const char *path) {
+    FILE *file = fopen(path, "wb");
+    if (!file) {
+        return NULL;
+    }
+    IWriter *writer = (IWriter*) malloc(sizeof(IWriter));
+    writer->file = file;
+    writer->failed = 0;
+    writer->used = 0;
+    summary_init(&writer->summary);
+    /* the header is rewritten once the elements are known */
+    unsigned char header[IFILE_HEADER_SIZE] = { 0 };
+    if (fwrite(header, 1, IFILE_HEADER_SIZE, file) != IFILE_HEADER_SIZE) {
+        writer->failed = 1;
+    }
+    return writer;
+}
+
+int writer_put(IWriter *writer, int value) {
+    if (writer->summary.count + writer->used == INT_MAX) {
+        writer->failed = 1;
+    }
+    if (writer->failed) {
+        return -1;
+    }
+    writer->buffer[writer->used++] = (unsigned) value;
+    if (writer->used == BUFFER_SIZE) {
+        flush(writer);
+    }
+    return writer->failed ? -1 : 0;
+}
+
+int writer_put_list(IWriter *writer, IList *list) {
+    for (Node *cur = list->first; cur; cur = cur->next) {
+        if (writer_put(writer, cur->value) != 0) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+int close_writer(IWriter **writer) {
+    IWriter *w = *writer;
+    flush(w);
+    unsigned char header[IFILE_HEADER_SIZE];
+    encode_header(header, &w->summary);
+    if (fseek(w->file, 0, SEEK_SET) != 0 || fwrite(header, 1, IFILE_HEADER_SIZE, w->file) != IFILE_HEADER_SIZE) {
+        w->failed = 1;
+    }
+    if (fclose(w->file) != 0) {
+        w->failed = 1;
+    }
+    int result = w->failed ? -1 : 0;
+    free(w);
+    *writer = NULL;
+    return result;
+}
+
+IReader* open_reader(const char *path) {
+    FILE *file = fopen(path, "rb");
+    if (!file) {
+        return NULL;
+    }
+    unsigned char header[IFILE_HEADER_SIZE];
+    IReader *reader = (IReader*) malloc(sizeof(IReader));
+    if (fread(header, 1, IFILE_HEADER_SIZE, file) != IFILE_HEADER_SIZE
+            || !decode_header(header, &reader->summary, &reader->checksum)) {
+        fclose(file);
+        free(reader);
+        return NULL;
+    }
+    reader->file = file;
+    reader->size = (int) reader->summary.count;
+    reader->read = 0;
+    reader->failed = 0;
+    reader->used = 0;
+    reader->available = 0;
+    summary_init(&reader->summary);
+    return reader;
+}
+
+int reader_size(IReader *reader) {
+    return reader->size;
+}
+
+int reader_next(IReader *reader, int *value) {
+    if (reader->used == reader->available) {
+        int wanted = reader->size - reader->read;
+        if (wanted > BUFFER_SIZE) {
+            wanted = BUFFER_SIZE;
+        }
+        if (wanted == 0 || reader->failed) {
+            return 0;
+        }
+        int got = (int) fread(reader->buffer, sizeof(unsigned), wanted, reader->file);
+        if (got < wanted) {
+            reader->failed = 1;
+        }
+        to_little_endian(reader->buffer, got);
+        summary_add(&reader->summary, (int*) reader->buffer, got);
+        reader->read += got;
+        reader->used = 0;
+        reader->available = got;
+        if (got == 0) {
+            return 0;
+        }
+    }
+    *value = (int) reader->buffer[reader->used++];
+    return 1;
+}
+
+int close_reader(IReader **reader) {
+    IReader *r = *reader;
+    int result = 0;
+    if (r->failed || (r->read == r->size && summary_checksum(&r->summary) != r->checksum)) {
+        result = -1;
+    }
+    fclose(r->file);
+    free(r);
+    *reader = NULL;
+    return result;
+}
+
+IView* open_view(const char *path) {
+    if (!is_little_endian()) {
+        /* the mapped elements are used in place */
+        return NULL;
+    }
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return NULL;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < IFILE_HEADER_SIZE) {
+        close(fd);
+        return NULL;
+    }
+    void *map = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        return NULL;
+    }
+    Summary summary;
+    unsigned long long checksum;
+    if (!decode_header((const unsigned char*) map, &summary, &checksum)
+            || IFILE_HEADER_SIZE + summary.count * sizeof(int) > (unsigned long long) st.st_size) {
+        munmap(map, st.st_size);
+        return NULL;
+    }
+    IView *view = (IView*) malloc(sizeof(IView));
+    view->values = (const int*) ((const unsigned char*) map + IFILE_HEADER_SIZE);
+    view->size = (int) summary.count;
+    view->min = summary.min;
+    view->max = summary.max;
+    view->checksum = checksum;
+    view->map = map;
+    view->map_size = st.st_size;
+    return view;
+}
+
+void close_view(IView **view) {
+    munmap((*view)->map, (*view)->map_size);
+    free(*view);
+    *view = NULL;
+}
+
+int view_verify(IView *view) {
+    Summary summary;
+    summary_init(&summary);
+    summary_add(&summary, view->values, view->size);
+    return summary_checksum(&summary) == view->checksum
+        && (view->size == 0 || (summary.min == view->min && summary.max == view->max));
+}
+
+int view_get_size(IView *view) {
+    return view->size;
+}
+
+int view_get(IView *view, int index) {
+    return view->values[index];
+}
+
+void view_foreach(IView *view, void (*op)(int)) {
+    for (int i = 0; i < view->size; i++) {
+        op(view->values[i]);
+    }
+}
+
+int view_fold_left(int init, IView *view, i_bifunc op) {
+    int acc = init;
+    for (int i = 0; i < view->size; i++) {
+        acc = op(acc, view->values[i]);
+    }
+    return acc;
+}
+
+int view_sum(IView *view) {
+    return sum_array(view->size, (int*) view->values);
+}
+
+long long view_sum64(IView *view) {
+    return sum64_array(view->size, (int*) view->values);
+}
+
+int view_max(IView *view) {
+    return view->max;
+}
+
+int view_min(IView *view) {
+    return view->min;
+}
+
+int view_contains(IView *view, int value) {
+    if (view->size == 0 || value < view->min || value > view->max) {
+        return 0;
+    }
+    return contains_array(view->size, (int*) view->values, value);
+}
+
+int view_index_of(IView *view, int value) {
+    if (view->size == 0 || value < view->min || value > view->max) {
+        return -1;
+    }
+    return index_of_array(view->size, (int*) view->values, value);
+}
+
+IList* view_to_list(IView *view) {
+    return from_array(view->size, (int*) view->values);
+}
@@ -0,0 +1,117 @@
+#ifndef IFILE_H_
+#define IFILE_H_
+
+#include "ilist.h"
+
+/* Binary list files
+
+    A file holds a 32-byte header followed by the elements as 32-bit
+    little-endian integers. The header stores, also little-endian:
+
+        0   magic "ILST"
+        4   format version (1)
+        8   number of elements (64 bits)
+        16  smallest element
+        20  largest element
+        24  checksum of the elements (64 bits)
+
+    The checksum is a Fletcher-style sum over the elements: a is the sum
+    of the elements and b the sum of the successive values of a, both
+    modulo 2^32, stored as b << 32 | a.
+
+    Functions that open or close files return NULL or -1 on failure. */
+
+#define IFILE_HEADER_SIZE 32
+
+typedef struct IWriter IWriter;
+typedef struct IReader IReader;
+
+/* Read-only view of a list file mapped into memory. Pages are loaded on first access. */
+typedef struct {
+    const int *values;
+    int size;
+    int min;
+    int max;
+    unsigned long long checksum;
+    void *map;
+    long map_size;
+} IView;
+
+/* Writes the list to the file. Returns 0 on success, -1 on failure. */
+extern int save_list(IList*, const char*);
+
+/* Reads a list from the file and verifies its checksum. Returns NULL on failure. */
+extern IList* load_list(const char*);
+
+/* Creates the file and returns a writer that appends elements to it. */
+extern IWriter* open_writer(const char*);
+
+/* Appends an element. Returns 0 on success, -1 on failure. */
+extern int writer_put(IWriter*, int);
+
+/* Appends the elements of the list. Returns 0 on success, -1 on failure. */
+extern int writer_put_list(IWriter*, IList*);
+
+/* Completes the header, closes the file and deletes the writer.
+    Returns 0 if every element was written, -1 otherwise. */
+extern int close_writer(IWriter**);
+
+/* Opens the file and reads its header. */
+extern IReader* open_reader(const char*);
+
+/* Returns the number of elements in the file of the reader. */
+extern int reader_size(IReader*);
+
+/* Stores the next element into the second argument and returns true,
+    or returns false if there are no more elements or the file is truncated. */
+extern int reader_next(IReader*, int*);
+
+/* Closes the file and deletes the reader. Returns -1 if the file was truncated or,
+    once every element was read, if the checksum does not match; 0 otherwise. */
+extern int close_reader(IReader**);
+
+/* Maps the file into memory. The header is checked but the checksum is not
+    (use view_verify), so opening does not touch the elements. */
+extern IView* open_view(const char*);
+
+/* Unmaps the file and deletes the view. */
+extern void close_view(IView**);
+
+/* Returns true if the checksum in the header matches the elements. Reads the whole file. */
+extern int view_verify(IView*);
+
+/* Returns a size of the view. */
+extern int view_get_size(IView*);
+
+/* Returns the element at the specified position. */
+extern int view_get(IView*, int);
+
+/* Performs the given action for each element of the view. */
+extern void view_foreach(IView*, void (*op)(int));
+
+/* Applies a binary operator to a start value and all elements of the view, going left to right. */
+extern int view_fold_left(int, IView*, i_bifunc);
+
+/* Sums up the elements of the view. */
+extern int view_sum(IView*);
+
+/* Sums up the elements of the view into a 64-bit accumulator. */
+extern long long view_sum64(IView*);
+
+/* Finds the largest element of the view (from the header). */
+extern int view_max(IView*);
+
+/* Finds the smallest element of the view (from the header). */
+extern int view_min(IView*);
+
+/* Returns true if the view contains the specified element. */
+extern int view_contains(IView*, int);
+
+/* Returns the index of the first occurrence of the specified element in the view,
+    or -1 if the view does not contain the element. */
+extern int view_index_of(IView*, int);
+
+/* Returns a list containing the elements of the view. */
+extern IList* view_to_list(IView*);
+
+#endif
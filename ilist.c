@@ -1,7 +1,147 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <stdarg.h>
+#include <string.h>
 #include "ilist.h"
+#include "node_pool.h"
+#include "iset.h"
+#include "list_index.h"
+#include "list_aggregates.h"
+#include "istats.h"
+#include "icallback.h"
+
+static Node* new_node(IList *list, int value) {
+    Node *node = list->pool ? pool_alloc(list->pool) : (Node*) malloc(sizeof(Node));
+    STATS_ALLOC(list, 1);
+    node->value = value;
+    node->next = NULL;
+    if (list->aggregates) {
+        aggregates_added(list->aggregates, value);
+    }
+    return node;
+}
+
+/* Keep the positional index, if any, in step with structural changes. */
+
+static void indexed_insert(IList *list, int pos, int n) {
+    if (list->index) {
+        index_inserted(list->index, pos, n);
+    }
+}
+
+static void indexed_remove(IList *list, int pos, Node *node) {
+    if (list->index) {
+        index_removed(list->index, pos, node);
+    }
+}
+
+static void invalidate_index(IList *list) {
+    if (list->index) {
+        index_invalidate(list->index);
+    }
+}
+
+/* Keep the tracked aggregates, if any, in step with the values. Nodes report their
+    values as they are allocated and freed; these cover order and bulk changes. */
+
+static void tracked_adjacent(IList *list, Node *before, Node *after) {
+    if (list->aggregates && before && after) {
+        aggregates_adjacent(list->aggregates, before->value, after->value);
+    }
+}
+
+static void tracked_reordered(IList *list, int ascending) {
+    if (list->aggregates) {
+        aggregates_reordered(list->aggregates, ascending);
+    }
+}
+
+static void tracked_invalidate(IList *list) {
+    if (list->aggregates) {
+        aggregates_invalidate(list->aggregates);
+    }
+}
+
+static void free_node(IList *list, Node *node) {
+    STATS_FREE(list, 1);
+    if (list->aggregates) {
+        aggregates_removed(list->aggregates, node->value);
+    }
+    if (list->pool) {
+        pool_free(list->pool, node);
+    } else {
+        free(node);
+    }
+}
+
+/* Unlinks the node that follows prev (or the first node if prev is NULL) and frees it. */
+static void unlink_node(IList *list, Node *prev, Node *node) {
+    if (prev) {
+        prev->next = node->next;
+    } else {
+        list->first = node->next;
+    }
+    if (list->last == node) {
+        list->last = prev;
+    }
+    list->size--;
+    invalidate_index(list);
+    free_node(list, node);
+}
+
+/* Nodes can only move between lists that share an allocator. Returns the other list
+    if it shares the allocator of this one; otherwise empties it and returns a copy
+    allocated like this one. Pass the result to moved once its nodes are taken. */
+static IList* movable(IList *list, IList *other) {
+    if (other->pool == list->pool) {
+        return other;
+    }
+    IList *copy = clone_in(other, list->pool);
+    while (is_not_empty(other)) {
+        drop(other);
+    }
+    return copy;
+}
+
+/* Empties a list returned by movable whose nodes were taken, and deletes it if it is
+    a copy, which also releases its count on a shared pool. */
+static void moved(IList *src, IList *other) {
+    src->first = NULL;
+    src->last = NULL;
+    src->size = 0;
+    invalidate_index(other);
+    tracked_invalidate(other);
+    if (src != other) {
+        delete_list(&src);
+    }
+}
+
+NodePool* derived_pool(IList *list) {
+    return list->pool && !list->pool->shared ? list->pool : NULL;
+}
+
+/* Returns a list of the chain of count nodes from first to last, which the caller
+    has unlinked from the list and terminated. The block of a list built in bulk
+    stays private to it, so those nodes are copied and handed back to its pool. */
+static IList* chain_list(IList *list, Node *first, Node *last, int count) {
+    if (!first) {
+        return empty_list_in(derived_pool(list));
+    }
+    if (list->pool && list->pool->shared) {
+        IList *result = empty_list();
+        for (Node *cur = first; cur; cur = cur->next) {
+            push_back(result, cur->value);
+        }
+        STATS_FREE(list, count);
+        pool_free_chain(list->pool, first, last);
+        return result;
+    }
+    IList *result = empty_list_in(list->pool);
+    result->first = first;
+    result->last = last;
+    result->size = count;
+    return result;
+}
 
 int is_empty(IList *list) {
     return list->size == 0;
@@ -12,28 +152,74 @@ int is_not_empty(IList *list) {
 }
 
 IList* empty_list() {
+    return empty_list_in(NULL);
+}
+
+IList* empty_list_in(NodePool *pool) {
     IList *list = (IList*) malloc(sizeof(IList));
+    list->first = NULL;
+    list->last = NULL;
     list->size = 0;
+    list->pool = pool;
+    list->index = NULL;
+    list->aggregates = NULL;
+#ifdef ILIST_INSTRUMENT
+    list->counters = (IListCounters) { 0, 0, 0 };
+#endif
+    if (pool && pool->shared) {
+        pool->lists++;
+    }
     return list;
 }
 
-IList* single_list_of(int value) {
-    Node *node = (Node*) malloc(sizeof(Node));
-    node->value = value;
-    node->next = NULL;
-    IList *list = (IList*) malloc(sizeof(IList));
-    list->first = node;
-    list->last = node;
-    list->size = 1;
+/* Returns a list of count nodes allocated in one block of a shared pool and linked
+    in order. The caller fills in the values. */
+static IList* bulk_list(int count) {
+    if (count <= 0) {
+        return empty_list();
+    }
+    IList *list = empty_list_in(new_shared_pool());
+    Node *nodes = pool_alloc_n(list->pool, count);
+    STATS_ALLOC(list, count);
+    for (int i = 0; i < count - 1; i++) {
+        nodes[i].next = &nodes[i + 1];
+    }
+    nodes[count - 1].next = NULL;
+    list->first = nodes;
+    list->last = &nodes[count - 1];
+    list->size = count;
+    return list;
+}
+
+/* Returns the number of elements from first towards last (inclusive) by step. */
+static int range_count(long long first, long long last, int step) {
+    if (step > 0 && first <= last) {
+        return (int) ((last - first) / step + 1);
+    } else if (step < 0 && first >= last) {
+        return (int) ((first - last) / -(long long) step + 1);
+    }
+    return 0;
+}
+
+static IList* bulk_range(int first, int count, int step) {
+    IList *list = bulk_list(count);
+    long long value = first;
+    for (Node *cur = list->first; cur; cur = cur->next, value += step) {
+        cur->value = (int) value;
+    }
     return list;
 }
 
+IList* single_list_of(int value) {
+    return push_back(empty_list(), value);
+}
+
 IList* list_of(int count, ...) {
     va_list items;
     va_start(items, count);
-    IList *list = (IList*) malloc(sizeof(IList));
-    for (int i = 0; i < count; i++) {
-        push_back(list, va_arg(items, int));
+    IList *list = bulk_list(count);
+    for (Node *cur = list->first; cur; cur = cur->next) {
+        cur->value = va_arg(items, int);
     }
     va_end(items);
     return list;
@@ -44,17 +230,7 @@ IList* range(int first, int last) {
 }
 
 IList* range_step(int first, int last, int step) {
-    IList *list = empty_list();
-    if (step > 0) {
-        for (int i = first; i <= last; i += step) {
-            push_back(list, i);
-        }
-    } else {
-        for (int i = first; i >= last; i += step) {
-            push_back(list, i);
-        }
-    }
-    return list;
+    return bulk_range(first, range_count(first, last, step), step);
 }
 
 IList* range_ex(int first, int last) {
@@ -62,45 +238,63 @@ IList* range_ex(int first, int last) {
 }
 
 IList* range_step_ex(int first, int last, int step) {
-    IList *list = empty_list();
-    if (step > 0) {
-        for (int i = first; i < last; i += step) {
-            push_back(list, i);
-        }
-    } else {
-        for (int i = first; i > last; i += step) {
-            push_back(list, i);
+    long long end = step > 0 ? (long long) last - 1 : (long long) last + 1;
+    return bulk_range(first, range_count(first, end, step), step);
+}
+
+static IList* generate_count(int start, const Callback *op, int count) {
+    IList *list = bulk_list(count);
+    int value = start;
+    for (Node *cur = list->first; cur; cur = cur->next) {
+        cur->value = value;
+        if (cur->next) {
+            value = apply(op, value);
         }
     }
     return list;
 }
 
 IList* generate_n(int start, i_func op, int count) {
+    return generate_count(start, PLAIN(op), count);
+}
+
+IList* generate_n_ctx(int start, i_func_ctx op, int count, void *ctx) {
+    return generate_count(start, WITH_CTX(op, ctx), count);
+}
+
+static IList* generate_until(int start, const Callback *op, const Callback *cond) {
     IList *list = empty_list();
-    for (int cur = start, i = 0; i < count; cur = op(cur), i++) {
+    for (int cur = start; apply(cond, cur); cur = apply(op, cur)) {
         push_back(list, cur);
     }
     return list;
 }
 
 IList* generate_while(int start, i_func op, i_func cond) {
-    IList *list = empty_list();
-    for (int cur = start; cond(cur); cur = op(cur)) {
-        push_back(list, cur);
-    }
-    return list;
+    return generate_until(start, PLAIN(op), PLAIN(cond));
+}
+
+IList* generate_while_ctx(int start, i_func_ctx op, i_func_ctx cond, void *ctx) {
+    return generate_until(start, WITH_CTX(op, ctx), WITH_CTX(cond, ctx));
 }
 
 IList* repeat(int value, int count) {
-    IList *list = empty_list();
-    for (int i = 0; i < count; i++) {
-        push(list, value);
+    IList *list = bulk_list(count);
+    for (Node *cur = list->first; cur; cur = cur->next) {
+        cur->value = value;
     }
     return list;
 }
 
 void delete_list(IList **list) {
-    if (is_not_empty(*list)) {
+    STATS_FREE(*list, (*list)->size);
+    NodePool *pool = (*list)->pool;
+    if (pool && pool->shared && --pool->lists == 0) {
+        /* the last list of a shared pool frees every node at once */
+        delete_pool(&pool);
+    } else if (is_not_empty(*list) && (*list)->pool) {
+        pool_free_chain((*list)->pool, (*list)->first, (*list)->last);
+    } else if (is_not_empty(*list)) {
         Node *node;
         while ((*list)->first->next) {
             node = (*list)->first;
@@ -109,6 +303,12 @@ void delete_list(IList **list) {
         }
         free((*list)->first);
     }
+    if ((*list)->index) {
+        delete_list_index(&(*list)->index);
+    }
+    if ((*list)->aggregates) {
+        delete_list_aggregates(&(*list)->aggregates);
+    }
     free(*list);
 }
 
@@ -129,8 +329,8 @@ int get_size(IList *list) {
 }
 
 IList* push(IList* list, int value) {
-    Node *node = (Node*) malloc(sizeof(Node));
-    node->value = value;
+    STATS_ENTER();
+    Node *node = new_node(list, value);
     if (is_empty(list)) {
         list->last = node;
     } else {
@@ -138,35 +338,44 @@ IList* push(IList* list, int value) {
     }
     list->first = node;
     list->size++;
+    indexed_insert(list, 0, 1);
+    tracked_adjacent(list, node, node->next);
+    STATS_EXIT();
+    return list;
 }
 
 IList* push_back(IList* list, int value) {
-    Node *node = (Node*) malloc(sizeof(Node));
-    node->value = value;
-    node->next = NULL;
+    STATS_ENTER();
+    Node *node = new_node(list, value);
     if (is_empty(list)) {
         list->first = node;
     } else {
+        tracked_adjacent(list, list->last, node);
         list->last->next = node;
     }
     list->last = node;
     list->size++;
+    STATS_EXIT();
     return list;
 }
 
 IList* insert(IList *list, int pos, int value) {
+    STATS_ENTER();
     if (pos == 0) {
         push(list, value);
     } else if (pos == list->size) {
         push_back(list, value);
     } else {
-        Node *node = (Node*) malloc(sizeof(Node));
-        node->value = value;
-        Node *prev = get_node(list, pos - 2);
+        Node *node = new_node(list, value);
+        Node *prev = get_node(list, pos - 1);
         node->next = prev->next;
         prev->next = node;
         list->size++;
+        indexed_insert(list, pos, 1);
+        tracked_adjacent(list, prev, node);
+        tracked_adjacent(list, node, node->next);
     }
+    STATS_EXIT();
     return list;
 }
 
@@ -183,45 +392,68 @@ int pop_back(IList *list) {
 }
 
 IList* delete(IList *list, int pos) {
-    Node *prev = get_node(list, pos - 1);
-    Node *del = prev->next;
-    prev->next = del->next;
-    free(del);
+    STATS_ENTER();
+    if (pos == 0) {
+        drop(list);
+    } else if (pos == list->size - 1) {
+        drop_back(list);
+    } else {
+        Node *prev = get_node(list, pos - 1);
+        Node *del = prev->next;
+        indexed_remove(list, pos, del);
+        prev->next = del->next;
+        list->size--;
+        free_node(list, del);
+    }
+    STATS_EXIT();
     return list;
 }
 
 IList* delete_item(IList *list, int value) {
-    int index = index_of(list, value);
-    while (index != -1) {
-        delete(list, index);
-        index = index_of(list, value);
+    Node *prev = NULL;
+    Node *cur = list->first;
+    while (cur) {
+        Node *next = cur->next;
+        if (cur->value == value) {
+            unlink_node(list, prev, cur);
+        } else {
+            prev = cur;
+        }
+        cur = next;
     }
     return list;
 }
 
 IList* drop(IList *list) {
+    STATS_ENTER();
     Node *node = list->first;
+    indexed_remove(list, 0, node);
     if (list->size == 1) {
         list->last = NULL;
     }
     list->first = node->next;
     list->size--;
-    free(node);
+    free_node(list, node);
+    STATS_EXIT();
     return list;
 }
 
 IList* drop_back(IList *list) {
+    STATS_ENTER();
     Node *node = list->last;
     if (list->size == 1) {
+        indexed_remove(list, 0, node);
         list->first = NULL;
         list->last = NULL;
     } else {
         Node *prev = get_node(list, list->size - 2);
+        indexed_remove(list, list->size - 1, node);
         prev->next = NULL;
         list->last = prev;
     }
     list->size--;
-    free(node);
+    free_node(list, node);
+    STATS_EXIT();
     return list;
 }
 
@@ -239,44 +471,70 @@ IList* drop_back_n(IList *list, int n) {
     return list;
 }
 
-IList* drop_while(IList *list, i_func pred) {
-    while (list->first && pred(list->first->value)) {
+static IList* drop_front_where(IList *list, const Callback *pred) {
+    while (list->first && apply(pred, list->first->value)) {
         drop(list);
     }
     return list;
 }
 
-IList* drop_back_while(IList *list, i_func pred) {
-    while (list->last && pred(list->last->value)) {
+IList* drop_while(IList *list, i_func pred) {
+    return drop_front_where(list, PLAIN(pred));
+}
+
+IList* drop_while_ctx(IList *list, i_func_ctx pred, void *ctx) {
+    return drop_front_where(list, WITH_CTX(pred, ctx));
+}
+
+static IList* drop_back_where(IList *list, const Callback *pred) {
+    while (list->last && apply(pred, list->last->value)) {
         drop_back(list);
     }
     return list;
 }
 
+IList* drop_back_while(IList *list, i_func pred) {
+    return drop_back_where(list, PLAIN(pred));
+}
+
+IList* drop_back_while_ctx(IList *list, i_func_ctx pred, void *ctx) {
+    return drop_back_where(list, WITH_CTX(pred, ctx));
+}
+
 IList* update(IList *list, int pos, int value) {
-    get_node(list, pos)->value = value;
+    STATS_ENTER();
+    Node *node = get_node(list, pos);
+    if (list->aggregates) {
+        aggregates_removed(list->aggregates, node->value);
+        aggregates_added(list->aggregates, value);
+        aggregates_reordered(list->aggregates, 0);
+    }
+    node->value = value;
+    STATS_EXIT();
     return list;
 }
 
 IList* sublist(IList *list, int start, int end) {
-    for (int i = 0; i < list->size - end; i++) {
-        drop_back(list);
-    }
+    STATS_ENTER();
+    IList *rest = split_at(list, end);
+    delete_list(&rest);
     for (int i = 0; i < start; i++) {
         drop(list);
     }
+    STATS_EXIT();
     return list;
 }
 
 IList* from_array(int size, int *arr) {
-    IList *result = empty_list();
-    if (arr == NULL || size == 0) {
-        return result;
+    if (arr == NULL) {
+        return empty_list();
     }
-    for (int i = 0; i < size; i++) {
-        push_back(result, arr[i]);
+    IList *list = bulk_list(size);
+    int ind = 0;
+    for (Node *cur = list->first; cur; cur = cur->next) {
+        cur->value = arr[ind++];
     }
-    return result;
+    return list;
 }
 
 int* to_array(IList *list) {
@@ -288,12 +546,84 @@ int* to_array(IList *list) {
     return arr;
 }
 
+int to_array_into(IList *list, int *buf, int cap) {
+    int ind = 0;
+    for (Node *cur = list->first; cur && ind < cap; cur = cur->next) {
+        buf[ind++] = cur->value;
+    }
+    return ind;
+}
+
+IList* append_array(IList *list, int count, int *arr) {
+    STATS_ENTER();
+    if (count > 0) {
+        Node *first;
+        Node *last;
+        if (list->pool) {
+            Node *nodes = pool_alloc_n(list->pool, count);
+            STATS_ALLOC(list, count);
+            for (int i = 0; i < count; i++) {
+                nodes[i].value = arr[i];
+                nodes[i].next = &nodes[i + 1];
+            }
+            if (list->aggregates) {
+                for (int i = 0; i < count; i++) {
+                    aggregates_added(list->aggregates, arr[i]);
+                }
+            }
+            first = nodes;
+            last = &nodes[count - 1];
+        } else {
+            first = last = new_node(list, arr[0]);
+            for (int i = 1; i < count; i++) {
+                last->next = new_node(list, arr[i]);
+                last = last->next;
+            }
+        }
+        last->next = NULL;
+        if (list->aggregates) {
+            for (int i = 1; i < count; i++) {
+                aggregates_adjacent(list->aggregates, arr[i - 1], arr[i]);
+            }
+        }
+        if (is_empty(list)) {
+            list->first = first;
+        } else {
+            tracked_adjacent(list, list->last, first);
+            list->last->next = first;
+        }
+        list->last = last;
+        list->size += count;
+    }
+    STATS_EXIT();
+    return list;
+}
+
+IListBlocks list_blocks(IList *list, int *buf, int cap) {
+    return (IListBlocks) { list->first, buf, cap };
+}
+
+int list_next_block(IListBlocks *blocks, int **values) {
+    int count = 0;
+    for (; blocks->next && count < blocks->cap; blocks->next = blocks->next->next) {
+        blocks->buf[count++] = blocks->next->value;
+    }
+    *values = blocks->buf;
+    return count;
+}
+
 void foreach(IList *list, void (*op)(int)) {
     for (Node *cur = list->first; cur; cur = cur->next) {
         op(cur->value);
     }
 }
 
+void foreach_ctx(IList *list, void (*op)(int, void*), void *ctx) {
+    for (Node *cur = list->first; cur; cur = cur->next) {
+        op(cur->value, ctx);
+    }
+}
+
 void print_list(IList *list) {
     printf("IList %p : [", list);
     if (is_not_empty(list)) {
@@ -306,10 +636,12 @@ void print_list(IList *list) {
 }
 
 IList* reverse(IList *list) {
-    IList *result = empty_list();
+    STATS_ENTER();
+    IList *result = empty_list_in(derived_pool(list));
     for (Node *cur = list->first; cur; cur = cur->next) {
         push(result, cur->value);
     }
+    STATS_EXIT();
     return result;
 }
 
@@ -326,9 +658,13 @@ Node* get_node(IList *list, int index) {
         return get_first_node(list);
     } else if (index == list->size - 1) {
         return get_last_node(list);
+    } else if (list->index && index > 0 && index < list->size) {
+        return index_get_node(list->index, list, index);
     } else {
         Node* cur = list->first;
-        for (int i = 0; cur && i < index; cur = cur->next, i++);
+        int i = 0;
+        for (; cur && i < index; cur = cur->next, i++);
+        STATS_STEPS(list, i);
         return cur;
     }
 }
@@ -342,7 +678,10 @@ int get_last(IList *list) {
 }
 
 int get(IList *list, int index) {
-    return get_node(list, index)->value;
+    STATS_ENTER();
+    int value = get_node(list, index)->value;
+    STATS_EXIT();
+    return value;
 }
 
 int find(IList *list, i_func pred) {
@@ -353,22 +692,43 @@ int find_not(IList *list, i_func pred) {
     return find_not_or(list, pred, 0);
 }
 
-int find_or(IList *list, i_func pred, int default_value) {
+int find_ctx(IList *list, i_func_ctx pred, void *ctx) {
+    return find_or_ctx(list, pred, 0, ctx);
+}
+
+int find_not_ctx(IList *list, i_func_ctx pred, void *ctx) {
+    return find_not_or_ctx(list, pred, 0, ctx);
+}
+
+/* Returns the first node for which the predicate is true (or false if wanted is),
+    or NULL. */
+static Node* find_where(IList *list, const Callback *pred, int wanted) {
     for (Node *cur = list->first; cur; cur = cur->next) {
-        if (pred(cur->value)) {
-            return cur->value;
+        if (!apply(pred, cur->value) == !wanted) {
+            return cur;
         }
     }
-    return default_value;
+    return NULL;
+}
+
+int find_or(IList *list, i_func pred, int default_value) {
+    Node *node = find_where(list, PLAIN(pred), 1);
+    return node ? node->value : default_value;
 }
 
 int find_not_or(IList *list, i_func pred, int default_value) {
-    for (Node *cur = list->first; cur; cur = cur->next) {
-        if (!pred(cur->value)) {
-            return cur->value;
-        }
-    }
-    return default_value;
+    Node *node = find_where(list, PLAIN(pred), 0);
+    return node ? node->value : default_value;
+}
+
+int find_or_ctx(IList *list, i_func_ctx pred, int default_value, void *ctx) {
+    Node *node = find_where(list, WITH_CTX(pred, ctx), 1);
+    return node ? node->value : default_value;
+}
+
+int find_not_or_ctx(IList *list, i_func_ctx pred, int default_value, void *ctx) {
+    Node *node = find_where(list, WITH_CTX(pred, ctx), 0);
+    return node ? node->value : default_value;
 }
 
 int index_of(IList *list, int item) {
@@ -395,38 +755,71 @@ int last_index_of(IList *list, int item) {
 }
 
 IList* clone(IList *list) {
-    IList *result = empty_list();
+    if (list->pool && list->pool->shared) {
+        /* a block of its own, so that the copy shares no pool with the original */
+        IList *result = bulk_list(list->size);
+        Node *dst = result->first;
+        for (Node *cur = list->first; cur; cur = cur->next, dst = dst->next) {
+            dst->value = cur->value;
+        }
+        return result;
+    }
+    return clone_in(list, list->pool);
+}
+
+IList* clone_in(IList *list, NodePool *pool) {
+    STATS_ENTER();
+    IList *result = empty_list_in(pool);
     for (Node *cur = list->first; cur; cur = cur->next) {
         push_back(result, cur->value);
     }
+    STATS_EXIT();
     return result;
 }
 
-IList* map(IList *list, i_func op) {
+static IList* map_with(IList *list, const Callback *op) {
     for (Node *cur = list->first; cur; cur = cur->next) {
-        cur->value = op(cur->value);
+        cur->value = apply(op, cur->value);
+    }
+    if (list->aggregates) {
+        aggregates_rebuild(list->aggregates, list);
     }
     return list;
 }
 
-IList* filter(IList *list, i_func pred) {
-    IList *result = empty_list();
+IList* map(IList *list, i_func op) {
+    return map_with(list, PLAIN(op));
+}
+
+IList* map_ctx(IList *list, i_func_ctx op, void *ctx) {
+    return map_with(list, WITH_CTX(op, ctx));
+}
+
+/* Returns a new list of the elements for which the predicate is true (or false if keep is). */
+static IList* filter_where(IList *list, const Callback *pred, int keep) {
+    IList *result = empty_list_in(derived_pool(list));
     for (Node *cur = list->first; cur; cur = cur->next) {
-        if (pred(cur->value)) {
+        if (!apply(pred, cur->value) == !keep) {
             push_back(result, cur->value);
         }
     }
     return result;
 }
 
+IList* filter(IList *list, i_func pred) {
+    return filter_where(list, PLAIN(pred), 1);
+}
+
 IList* filter_not(IList *list, i_func pred) {
-    IList *result = empty_list();
-    for (Node *cur = list->first; cur; cur = cur->next) {
-        if (!pred(cur->value)) {
-            push_back(result, cur->value);
-        }
-    }
-    return result;
+    return filter_where(list, PLAIN(pred), 0);
+}
+
+IList* filter_ctx(IList *list, i_func_ctx pred, void *ctx) {
+    return filter_where(list, WITH_CTX(pred, ctx), 1);
+}
+
+IList* filter_not_ctx(IList *list, i_func_ctx pred, void *ctx) {
+    return filter_where(list, WITH_CTX(pred, ctx), 0);
 }
 
 IList* add_all(IList *list, IList *elems) {
@@ -436,7 +829,90 @@ IList* add_all(IList *list, IList *elems) {
     return list;
 }
 
+IList* concat_move(IList *list, IList *other) {
+    return splice(list, list->size, other);
+}
+
+IList* splice(IList *list, int pos, IList *other) {
+    IList *src = movable(list, other);
+    if (is_not_empty(src)) {
+        if (pos == 0) {
+            src->last->next = list->first;
+            list->first = src->first;
+            if (is_empty(list)) {
+                list->last = src->last;
+            }
+        } else {
+            Node *prev = pos == list->size ? list->last : get_node(list, pos - 1);
+            src->last->next = prev->next;
+            prev->next = src->first;
+            if (prev == list->last) {
+                list->last = src->last;
+            }
+        }
+        indexed_insert(list, pos, src->size);
+        tracked_invalidate(list);
+        list->size += src->size;
+    }
+    moved(src, other);
+    return list;
+}
+
+/* Moves the nodes after prev (all nodes if prev is NULL) into a new list. */
+static IList* cut_after(IList *list, Node *prev, int kept) {
+    Node *first = prev ? prev->next : list->first;
+    IList *rest = chain_list(list, first, list->last, list->size - kept);
+    if (first) {
+        if (prev) {
+            prev->next = NULL;
+        } else {
+            list->first = NULL;
+        }
+        list->last = prev;
+        list->size = kept;
+        invalidate_index(list);
+        tracked_invalidate(list);
+    }
+    return rest;
+}
+
+IList* split_at(IList *list, int n) {
+    if (n >= list->size) {
+        return empty_list_in(derived_pool(list));
+    }
+    return n > 0 ? cut_after(list, get_node(list, n - 1), n) : cut_after(list, NULL, 0);
+}
+
+static IList* split_where(IList *list, const Callback *pred) {
+    Node *prev = NULL;
+    int kept = 0;
+    for (Node *cur = list->first; cur && apply(pred, cur->value); cur = cur->next) {
+        prev = cur;
+        kept++;
+    }
+    return cut_after(list, prev, kept);
+}
+
+IList* split_while(IList *list, i_func pred) {
+    return split_where(list, PLAIN(pred));
+}
+
+IList* split_while_ctx(IList *list, i_func_ctx pred, void *ctx) {
+    return split_where(list, WITH_CTX(pred, ctx));
+}
+
 int contains(IList *list, int value) {
+    if (list->aggregates && is_not_empty(list)) {
+        ListAggregates *aggregates = list->aggregates;
+        if (value < aggregates_min(aggregates, list) || value > aggregates_max(aggregates, list)) {
+            return 0;
+        }
+        if (aggregates_sorted(aggregates, list)) {
+            Node *cur = list->first;
+            for (; cur && cur->value < value; cur = cur->next);
+            return cur && cur->value == value;
+        }
+    }
     for (Node *cur = list->first; cur; cur = cur->next) {
         if (cur->value == value) {
             return 1;
@@ -445,57 +921,65 @@ int contains(IList *list, int value) {
     return 0;
 }
 
-int fold_left(int init, IList *list, i_bifunc op) {
+/* Applies the operator to the accumulator and each element from the node on, going left to right. */
+static int fold_from(int init, Node *first, const BiCallback *op) {
     int acc = init;
-    for (Node *cur = list->first; cur; cur = cur->next) {
-        acc = op(acc, cur->value);
+    for (Node *cur = first; cur; cur = cur->next) {
+        acc = combine(op, acc, cur->value);
     }
     return acc;
 }
 
-int reduce_left(IList *list, i_bifunc op) {
+/* Applies the operator to each element and the accumulator, going right to left;
+    the last element is the start value if there is no init. */
+static int fold_back(int init, int has_init, IList *list, const BiCallback *op) {
     if (is_empty(list)) {
-        return 0;
-    } else if (list->size == 1) {
-        return list->first->value;
-    } else {
-        Node *first = list->first;
-        list->first = list->first->next;
-        int result = fold_left(first->value, list, op);
-        list->first = first;
-        return result;
+        return init;
     }
-}
-
-int fold_right(int init, IList *list, i_bifunc op) {
-    int acc = init;
     IList *rev = reverse(list);
-    for (Node *cur = rev->first; cur; cur = cur->next) {
-        acc = op(cur->value, acc);
+    Node *first = has_init ? rev->first : rev->first->next;
+    int acc = has_init ? init : rev->first->value;
+    for (Node *cur = first; cur; cur = cur->next) {
+        acc = combine(op, cur->value, acc);
     }
     delete_list(&rev);
     return acc;
 }
 
-int reduce_right(IList *list, i_bifunc op) {
-    if (is_empty(list)) {
-        return 0;
-    } else if (list->size == 1) {
-        return list->first->value;
-    } else {
-        Node *prev = get_node(list, list->size - 2);
-        Node *last = list->last;
-        prev->next = NULL;
-        list->last = prev;
-        int result = fold_right(last->value, list, op);
-        prev->next = last;
-        list->last = last;
-        return result;
-    }
+int fold_left(int init, IList *list, i_bifunc op) {
+    return fold_from(init, list->first, PLAIN2(op));
+}
+
+int reduce_left(IList *list, i_bifunc op) {
+    return is_empty(list) ? 0 : fold_from(list->first->value, list->first->next, PLAIN2(op));
+}
+
+int fold_right(int init, IList *list, i_bifunc op) {
+    return fold_back(init, 1, list, PLAIN2(op));
+}
+
+int reduce_right(IList *list, i_bifunc op) {
+    return fold_back(0, 0, list, PLAIN2(op));
+}
+
+int fold_left_ctx(int init, IList *list, i_bifunc_ctx op, void *ctx) {
+    return fold_from(init, list->first, WITH_CTX2(op, ctx));
+}
+
+int reduce_left_ctx(IList *list, i_bifunc_ctx op, void *ctx) {
+    return is_empty(list) ? 0 : fold_from(list->first->value, list->first->next, WITH_CTX2(op, ctx));
+}
+
+int fold_right_ctx(int init, IList *list, i_bifunc_ctx op, void *ctx) {
+    return fold_back(init, 1, list, WITH_CTX2(op, ctx));
+}
+
+int reduce_right_ctx(IList *list, i_bifunc_ctx op, void *ctx) {
+    return fold_back(0, 0, list, WITH_CTX2(op, ctx));
 }
 
 IList* take(IList *list, int n) {
-    IList *result = empty_list();
+    IList *result = empty_list_in(derived_pool(list));
     Node *cur = list->first;
     for (int i = 0; i < n && cur; i++, cur = cur->next) {
         push_back(result, cur->value);
@@ -503,16 +987,24 @@ IList* take(IList *list, int n) {
     return result;
 }
 
-IList* take_while(IList *list, i_func pred) {
-    IList *result = empty_list();
-    for (Node *cur = list->first; cur && pred(cur->value); cur = cur->next) {
+static IList* take_where(IList *list, const Callback *pred) {
+    IList *result = empty_list_in(derived_pool(list));
+    for (Node *cur = list->first; cur && apply(pred, cur->value); cur = cur->next) {
         push_back(result, cur->value);
     }
     return result;
 }
 
+IList* take_while(IList *list, i_func pred) {
+    return take_where(list, PLAIN(pred));
+}
+
+IList* take_while_ctx(IList *list, i_func_ctx pred, void *ctx) {
+    return take_where(list, WITH_CTX(pred, ctx));
+}
+
 IList* take_right(IList *list, int n) {
-    IList *result = empty_list();
+    IList *result = empty_list_in(derived_pool(list));
     int i = 0;
     for (Node *cur = list->first; cur; cur = cur->next, i++) {
         if (i >= list->size - n) {
@@ -522,22 +1014,30 @@ IList* take_right(IList *list, int n) {
     return result;
 }
 
-IList* take_right_while(IList *list, i_func pred) {
+static IList* take_right_where(IList *list, const Callback *pred) {
     IList *rev = reverse(list);
-    IList *tw = take_while(rev, pred);
+    IList *tw = take_where(rev, pred);
     IList *result = take_right(list, tw->size);
     delete_list(&rev);
     delete_list(&tw);
     return result;
 }
 
+IList* take_right_while(IList *list, i_func pred) {
+    return take_right_where(list, PLAIN(pred));
+}
+
+IList* take_right_while_ctx(IList *list, i_func_ctx pred, void *ctx) {
+    return take_right_where(list, WITH_CTX(pred, ctx));
+}
+
 IList* slice(IList *list, int start, int end) {
     if (start == 0) {
         return take(list, end + 1);
     } else if (end == list->size - 1) {
         return take_right(list, end - start + 1);
     } else {
-        IList *result = empty_list();
+        IList *result = empty_list_in(derived_pool(list));
         int i = 0;
         for (Node *cur = list->first; cur; cur = cur->next, i++) {
             if (i >= start && i <= end) {
@@ -548,63 +1048,256 @@ IList* slice(IList *list, int start, int end) {
     }
 }
 
-int forall(IList *list, i_func pred) {
+static int count_where(IList *list, const Callback *pred) {
+    int count = 0;
     for (Node *cur = list->first; cur; cur = cur->next) {
-        if (!pred(cur->value)) {
-            return 0;
+        if (apply(pred, cur->value)) {
+            count++;
         }
     }
-    return 1;
+    return count;
+}
+
+int forall(IList *list, i_func pred) {
+    return find_where(list, PLAIN(pred), 0) == NULL;
 }
 
 int exists(IList *list, i_func pred) {
+    return find_where(list, PLAIN(pred), 1) != NULL;
+}
+
+int count(IList *list, i_func pred) {
+    return count_where(list, PLAIN(pred));
+}
+
+int forall_ctx(IList *list, i_func_ctx pred, void *ctx) {
+    return find_where(list, WITH_CTX(pred, ctx), 0) == NULL;
+}
+
+int exists_ctx(IList *list, i_func_ctx pred, void *ctx) {
+    return find_where(list, WITH_CTX(pred, ctx), 1) != NULL;
+}
+
+int count_ctx(IList *list, i_func_ctx pred, void *ctx) {
+    return count_where(list, WITH_CTX(pred, ctx));
+}
+
+IList* unique(IList *list) {
+    IList *result = empty_list_in(derived_pool(list));
+    ISet *seen = iset_empty(list->size);
     for (Node *cur = list->first; cur; cur = cur->next) {
-        if (pred(cur->value)) {
-            return 1;
+        if (iset_add(seen, cur->value)) {
+            push_back(result, cur->value);
         }
     }
-    return 0;
+    iset_delete(&seen);
+    return result;
 }
 
-int count(IList *list, i_func pred) {
-    int count = 0;
+IList* distinct(IList *list) {
+    ISet *seen = iset_empty(list->size);
+    Node *prev = NULL;
+    Node *cur = list->first;
+    while (cur) {
+        Node *next = cur->next;
+        if (iset_add(seen, cur->value)) {
+            prev = cur;
+        } else {
+            unlink_node(list, prev, cur);
+        }
+        cur = next;
+    }
+    iset_delete(&seen);
+    return list;
+}
+
+/* Unlinks in one pass the elements for which the predicate is not equal to keep. */
+static IList* retain_where(IList *list, const Callback *pred, int keep) {
+    Node *prev = NULL;
+    Node *cur = list->first;
+    while (cur) {
+        Node *next = cur->next;
+        if (!apply(pred, cur->value) == !keep) {
+            prev = cur;
+        } else {
+            unlink_node(list, prev, cur);
+        }
+        cur = next;
+    }
+    return list;
+}
+
+IList* retain_if(IList *list, i_func pred) {
+    return retain_where(list, PLAIN(pred), 1);
+}
+
+IList* remove_if(IList *list, i_func pred) {
+    return retain_where(list, PLAIN(pred), 0);
+}
+
+IList* retain_if_ctx(IList *list, i_func_ctx pred, void *ctx) {
+    return retain_where(list, WITH_CTX(pred, ctx), 1);
+}
+
+IList* remove_if_ctx(IList *list, i_func_ctx pred, void *ctx) {
+    return retain_where(list, WITH_CTX(pred, ctx), 0);
+}
+
+IList* dedup_adjacent(IList *list) {
+    Node *prev = list->first;
+    Node *cur = prev ? prev->next : NULL;
+    while (cur) {
+        Node *next = cur->next;
+        if (cur->value == prev->value) {
+            unlink_node(list, prev, cur);
+        } else {
+            prev = cur;
+        }
+        cur = next;
+    }
+    return list;
+}
+
+/* Relinks the nodes of the list into the matching ones, which stay, and the others,
+    which move to the returned list. */
+static IList* partition_where(IList *list, const Callback *pred) {
+    Node kept_head;
+    Node rest_head;
+    Node *kept_tail = &kept_head;
+    Node *rest_tail = &rest_head;
+    int kept = 0;
     for (Node *cur = list->first; cur; cur = cur->next) {
-        if (pred(cur->value)) {
-            count++;
+        if (apply(pred, cur->value)) {
+            kept_tail->next = cur;
+            kept_tail = cur;
+            kept++;
+        } else {
+            rest_tail->next = cur;
+            rest_tail = cur;
         }
     }
-    return count;
+    kept_tail->next = NULL;
+    rest_tail->next = NULL;
+    IList *rest = rest_tail == &rest_head ? chain_list(list, NULL, NULL, 0)
+        : chain_list(list, rest_head.next, rest_tail, list->size - kept);
+    list->first = kept_tail == &kept_head ? NULL : kept_head.next;
+    list->last = kept_tail == &kept_head ? NULL : kept_tail;
+    list->size = kept;
+    invalidate_index(list);
+    tracked_invalidate(list);
+    return rest;
 }
 
-IList* unique(IList *list) {
-    IList *result = empty_list();
+IList* partition(IList *list, i_func pred) {
+    return partition_where(list, PLAIN(pred));
+}
+
+IList* partition_ctx(IList *list, i_func_ctx pred, void *ctx) {
+    return partition_where(list, WITH_CTX(pred, ctx));
+}
+
+static IList* map_into_with(IList *list, const Callback *op, IList *dest) {
+    Node *out = dest->first;
+    Node *prev = NULL;
+    int written = 0;
+    for (Node *cur = list->first; cur; cur = cur->next) {
+        int value = apply(op, cur->value);
+        if (out) {
+            out->value = value;
+            prev = out;
+            out = out->next;
+        } else {
+            push_back(dest, value);
+            prev = dest->last;
+        }
+        written++;
+    }
+    IList *extra = cut_after(dest, prev, written);
+    delete_list(&extra);
+    tracked_invalidate(dest);
+    return dest;
+}
+
+IList* map_into(IList *list, i_func op, IList *dest) {
+    return map_into_with(list, PLAIN(op), dest);
+}
+
+IList* map_into_ctx(IList *list, i_func_ctx op, void *ctx, IList *dest) {
+    return map_into_with(list, WITH_CTX(op, ctx), dest);
+}
+
+IList* union_unsorted(IList *list, IList *other) {
+    IList *result = empty_list_in(derived_pool(list));
+    ISet *seen = iset_empty(list->size + other->size);
     for (Node *cur = list->first; cur; cur = cur->next) {
-        if (!contains(result, cur->value)) {
+        if (iset_add(seen, cur->value)) {
+            push_back(result, cur->value);
+        }
+    }
+    for (Node *cur = other->first; cur; cur = cur->next) {
+        if (iset_add(seen, cur->value)) {
             push_back(result, cur->value);
         }
     }
+    iset_delete(&seen);
     return result;
 }
 
-IList* distinct(IList *list) {
-    IList *buffer = empty_list();
+IList* intersect_unsorted(IList *list, IList *other) {
+    IList *result = empty_list_in(derived_pool(list));
+    ISet *rest = iset_from_list(other);
+    for (Node *cur = list->first; cur && iset_get_size(rest) > 0; cur = cur->next) {
+        /* removing the element keeps its later duplicates out */
+        if (iset_remove(rest, cur->value)) {
+            push_back(result, cur->value);
+        }
+    }
+    iset_delete(&rest);
+    return result;
+}
+
+IList* difference_unsorted(IList *list, IList *other) {
+    IList *result = empty_list_in(derived_pool(list));
+    ISet *excluded = iset_from_list(other);
     for (Node *cur = list->first; cur; cur = cur->next) {
-        if (contains(buffer, cur->value)) {
-            delete(list, index_of(list, cur->value));
-        } else {
-            push(buffer, cur->value);
+        if (iset_add(excluded, cur->value)) {
+            push_back(result, cur->value);
         }
     }
-    delete_list(&buffer);
-    return list;
+    iset_delete(&excluded);
+    return result;
+}
+
+IList* symmetric_difference_unsorted(IList *list, IList *other) {
+    IList *result = empty_list_in(derived_pool(list));
+    ISet *in_list = iset_from_list(list);
+    ISet *in_other = iset_from_list(other);
+    /* an element is removed from its own set once emitted; such elements
+        are never looked up in the second pass since the other list lacks them */
+    for (Node *cur = list->first; cur; cur = cur->next) {
+        if (!iset_contains(in_other, cur->value) && iset_remove(in_list, cur->value)) {
+            push_back(result, cur->value);
+        }
+    }
+    for (Node *cur = other->first; cur; cur = cur->next) {
+        if (!iset_contains(in_list, cur->value) && iset_remove(in_other, cur->value)) {
+            push_back(result, cur->value);
+        }
+    }
+    iset_delete(&in_list);
+    iset_delete(&in_other);
+    return result;
 }
 
 IList* swap(IList *list, int i, int j) {
+    STATS_ENTER();
     Node *ni = get_node(list, i);
     Node *nj = get_node(list, j);
     int vi = ni->value;
     ni->value = nj->value;
     nj->value = vi;
+    tracked_reordered(list, 0);
+    STATS_EXIT();
     return list;
 }
 
@@ -632,27 +1325,76 @@ int is_suffix(IList *list, IList *suffix) {
     return result;
 }
 
+/* Knuth-Morris-Pratt search of the sublist in the list. Returns the index of the first match
+    or -1. If matches is not NULL, appends the indexes of all (overlapping) matches to it. */
+static int search_sublist(IList *list, IList *sublist, IList *matches) {
+    int m = sublist->size;
+    int *pattern = to_array(sublist);
+    int *fail = (int*) malloc(m * sizeof(int));
+    fail[0] = 0;
+    for (int i = 1, k = 0; i < m; i++) {
+        while (k > 0 && pattern[i] != pattern[k]) {
+            k = fail[k - 1];
+        }
+        if (pattern[i] == pattern[k]) {
+            k++;
+        }
+        fail[i] = k;
+    }
+    int found = -1;
+    int k = 0;
+    int i = 0;
+    for (Node *cur = list->first; cur; cur = cur->next, i++) {
+        while (k > 0 && cur->value != pattern[k]) {
+            k = fail[k - 1];
+        }
+        if (cur->value == pattern[k]) {
+            k++;
+        }
+        if (k == m) {
+            if (found == -1) {
+                found = i - m + 1;
+            }
+            if (!matches) {
+                break;
+            }
+            push_back(matches, i - m + 1);
+            k = fail[k - 1];
+        }
+    }
+    free(pattern);
+    free(fail);
+    return found;
+}
+
 int is_sublist(IList *list, IList *sublist) {
+    return find_sublist(list, sublist) != -1;
+}
+
+int find_sublist(IList *list, IList *sublist) {
     if (is_empty(sublist)) {
-        return 1;
-    }
-    if (is_empty(list) || list->size < sublist->size) {
         return 0;
     }
-    IList *copy = clone(list);
-    do {
-        drop_n(copy, index_of(copy, sublist->first->value));
-        if (is_prefix(copy, sublist)) {
-            delete_list(&copy);
-            return 1;
+    if (list->size < sublist->size) {
+        return -1;
+    }
+    return search_sublist(list, sublist, NULL);
+}
+
+IList* find_all_sublists(IList *list, IList *sublist) {
+    IList *result = empty_list();
+    if (is_empty(sublist)) {
+        for (int i = 0; i <= list->size; i++) {
+            push_back(result, i);
         }
-    } while (copy->size > sublist->size);
-    delete_list(&copy);
-    return 0;
+    } else if (list->size >= sublist->size) {
+        search_sublist(list, sublist, result);
+    }
+    return result;
 }
 
 IList* intersperse(IList *list, int value) {
-    IList *result = empty_list();
+    IList *result = empty_list_in(derived_pool(list));
     if (is_not_empty(list)) {
         for (Node *cur = list->first; cur->next; cur = cur->next) {
             push_back(result, cur->value);
@@ -664,6 +1406,9 @@ IList* intersperse(IList *list, int value) {
 }
 
 int max(IList *list) {
+    if (list->aggregates) {
+        return aggregates_max(list->aggregates, list);
+    }
     int max = list->first->value;
     for (Node *cur = list->first; cur; cur = cur->next) {
         if (cur->value > max) {
@@ -674,6 +1419,9 @@ int max(IList *list) {
 }
 
 int min(IList *list) {
+    if (list->aggregates) {
+        return aggregates_min(list->aggregates, list);
+    }
     int min = list->first->value;
     for (Node *cur = list->first; cur; cur = cur->next) {
         if (cur->value < min) {
@@ -684,6 +1432,9 @@ int min(IList *list) {
 }
 
 int sum(IList *list) {
+    if (list->aggregates) {
+        return (int) aggregates_sum(list->aggregates, list);
+    }
     int sum = 0;
     for (Node *cur = list->first; cur; cur = cur->next) {
         sum += cur->value;
@@ -691,3 +1442,377 @@ int sum(IList *list) {
     return sum;
 }
 
+long long sum64(IList *list) {
+    if (list->aggregates) {
+        return aggregates_sum(list->aggregates, list);
+    }
+    long long sum = 0;
+    for (Node *cur = list->first; cur; cur = cur->next) {
+        sum += cur->value;
+    }
+    return sum;
+}
+
+/* A comparator with or without context; natural order if both are NULL. */
+typedef BiCallback Order;
+
+static const Order NATURAL = { NULL, NULL, NULL };
+
+static int less(const Order *order, int x, int y) {
+    if (order->plain || order->with_ctx) {
+        return combine(order, x, y) < 0;
+    }
+    return x < y;
+}
+
+/* Stable merge of two sorted chains, the first holding the earlier elements. */
+static Node* merge_nodes(Node *a, Node *b, const Order *order) {
+    Node head;
+    Node *t = &head;
+    while (a && b) {
+        if (less(order, b->value, a->value)) {
+            t->next = b;
+            b = b->next;
+        } else {
+            t->next = a;
+            a = a->next;
+        }
+        t = t->next;
+    }
+    t->next = a ? a : b;
+    return head.next;
+}
+
+/* Merge sort that relinks the nodes without allocation. Runs of 2^i nodes are
+    kept in pending[i] and merged like a binary counter, so merges stay local. */
+static void merge_sort(IList *list, const Order *order) {
+    if (list->size < 2) {
+        return;
+    }
+    Node *pending[32] = { NULL };
+    int depth = 0;
+    Node *cur = list->first;
+    while (cur) {
+        Node *run = cur;
+        cur = cur->next;
+        run->next = NULL;
+        int i = 0;
+        for (; pending[i]; i++) {
+            run = merge_nodes(pending[i], run, order);
+            pending[i] = NULL;
+        }
+        pending[i] = run;
+        if (i >= depth) {
+            depth = i + 1;
+        }
+    }
+    Node *result = NULL;
+    for (int i = 0; i < depth; i++) {
+        if (pending[i]) {
+            result = merge_nodes(pending[i], result, order);
+        }
+    }
+    invalidate_index(list);
+    tracked_reordered(list, order == &NATURAL);
+    list->first = result;
+    list->last = result;
+    while (list->last->next) {
+        list->last = list->last->next;
+    }
+}
+
+IList* sort(IList *list) {
+    STATS_ENTER();
+    merge_sort(list, &NATURAL);
+    STATS_EXIT();
+    return list;
+}
+
+IList* sort_by(IList *list, i_bifunc cmp) {
+    STATS_ENTER();
+    Order order = { cmp, NULL, NULL };
+    merge_sort(list, &order);
+    STATS_EXIT();
+    return list;
+}
+
+IList* sort_by_ctx(IList *list, i_bifunc_ctx cmp, void *ctx) {
+    STATS_ENTER();
+    Order order = { NULL, cmp, ctx };
+    merge_sort(list, &order);
+    STATS_EXIT();
+    return list;
+}
+
+IList* radix_sort(IList *list) {
+    STATS_ENTER();
+    if (list->size < 2) {
+        STATS_EXIT();
+        return list;
+    }
+    /* bits that differ between keys; a pass over a byte where none differ is skipped */
+    unsigned all = ~0u;
+    unsigned any = 0;
+    for (Node *cur = list->first; cur; cur = cur->next) {
+        all &= (unsigned) cur->value;
+        any |= (unsigned) cur->value;
+    }
+    Node *heads[256];
+    Node *tails[256];
+    for (int shift = 0; shift < 32; shift += 8) {
+        if ((((all ^ any) >> shift) & 0xFF) == 0) {
+            continue;
+        }
+        memset(heads, 0, sizeof(heads));
+        for (Node *cur = list->first; cur; cur = cur->next) {
+            /* flipping the sign bit orders negative keys before positive ones */
+            int bucket = (((unsigned) cur->value ^ 0x80000000u) >> shift) & 0xFF;
+            if (heads[bucket]) {
+                tails[bucket]->next = cur;
+            } else {
+                heads[bucket] = cur;
+            }
+            tails[bucket] = cur;
+        }
+        Node head;
+        Node *tail = &head;
+        for (int bucket = 0; bucket < 256; bucket++) {
+            if (heads[bucket]) {
+                tail->next = heads[bucket];
+                tail = tails[bucket];
+            }
+        }
+        tail->next = NULL;
+        list->first = head.next;
+        list->last = tail;
+        invalidate_index(list);
+    }
+    tracked_reordered(list, 1);
+    STATS_EXIT();
+    return list;
+}
+
+/* Returns true if no element is less than its predecessor. */
+static int in_order(IList *list, const Order *order) {
+    for (Node *cur = list->first; cur && cur->next; cur = cur->next) {
+        if (less(order, cur->next->value, cur->value)) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+int is_sorted(IList *list) {
+    if (list->aggregates) {
+        return aggregates_sorted(list->aggregates, list);
+    }
+    return in_order(list, &NATURAL);
+}
+
+int is_sorted_by(IList *list, i_bifunc cmp) {
+    Order order = { cmp, NULL, NULL };
+    return in_order(list, &order);
+}
+
+int is_sorted_by_ctx(IList *list, i_bifunc_ctx cmp, void *ctx) {
+    Order order = { NULL, cmp, ctx };
+    return in_order(list, &order);
+}
+
+IList* insert_sorted(IList *list, int value) {
+    if (is_empty(list) || !(value < list->last->value)) {
+        return push_back(list, value);
+    }
+    if (value < list->first->value) {
+        return push(list, value);
+    }
+    Node *prev = list->first;
+    int pos = 1;
+    while (!(value < prev->next->value)) {
+        prev = prev->next;
+        pos++;
+    }
+    Node *node = new_node(list, value);
+    node->next = prev->next;
+    prev->next = node;
+    list->size++;
+    indexed_insert(list, pos, 1);
+    tracked_adjacent(list, prev, node);
+    tracked_adjacent(list, node, node->next);
+    return list;
+}
+
+IList* merge_sorted(IList *list, IList *other) {
+    IList *src = movable(list, other);
+    if (is_not_empty(src)) {
+        if (is_empty(list) || src->last->value >= list->last->value) {
+            /* the nodes of the other list end up at the tail */
+            list->last = src->last;
+        }
+        list->first = merge_nodes(list->first, src->first, &NATURAL);
+        list->size += src->size;
+        invalidate_index(list);
+        tracked_invalidate(list);
+    }
+    moved(src, other);
+    return list;
+}
+
+/* Which elements a set operation keeps: those only in the first list,
+    those in both lists and those only in the second list. */
+#define KEEP_LEFT 1
+#define KEEP_BOTH 2
+#define KEEP_RIGHT 4
+
+/* Builds the distinct values of two sorted lists selected by keep, in one pass. */
+static IList* merge_sets(IList *list, IList *other, int keep) {
+    IList *result = empty_list_in(derived_pool(list));
+    Node *a = list->first;
+    Node *b = other->first;
+    while (a || b) {
+        if ((!a && !(keep & KEEP_RIGHT)) || (!b && !(keep & KEEP_LEFT))) {
+            break;
+        }
+        int value;
+        int side;
+        if (!b || (a && a->value < b->value)) {
+            value = a->value;
+            side = KEEP_LEFT;
+        } else if (!a || b->value < a->value) {
+            value = b->value;
+            side = KEEP_RIGHT;
+        } else {
+            value = a->value;
+            side = KEEP_BOTH;
+        }
+        if (keep & side) {
+            push_back(result, value);
+        }
+        while (a && a->value == value) {
+            a = a->next;
+        }
+        while (b && b->value == value) {
+            b = b->next;
+        }
+    }
+    return result;
+}
+
+/* Same as merge_sets, but relinks the kept nodes into this list
+    and frees the rest. The other list becomes empty. */
+static IList* splice_sets(IList *list, IList *other, int keep) {
+    IList *src = movable(list, other);
+    Node head;
+    Node *tail = &head;
+    int size = 0;
+    Node *a = list->first;
+    Node *b = src->first;
+    while (a || b) {
+        int value;
+        Node *kept;
+        if (!b || (a && a->value < b->value)) {
+            value = a->value;
+            kept = keep & KEEP_LEFT ? a : NULL;
+        } else if (!a || b->value < a->value) {
+            value = b->value;
+            kept = keep & KEEP_RIGHT ? b : NULL;
+        } else {
+            value = a->value;
+            kept = keep & KEEP_BOTH ? a : NULL;
+        }
+        while (a && a->value == value) {
+            Node *next = a->next;
+            if (a != kept) {
+                free_node(list, a);
+            }
+            a = next;
+        }
+        while (b && b->value == value) {
+            Node *next = b->next;
+            if (b != kept) {
+                free_node(src, b);
+            }
+            b = next;
+        }
+        if (kept) {
+            tail->next = kept;
+            tail = kept;
+            size++;
+        }
+    }
+    tail->next = NULL;
+    list->first = head.next;
+    list->last = size ? tail : NULL;
+    list->size = size;
+    invalidate_index(list);
+    tracked_invalidate(list);
+    moved(src, other);
+    return list;
+}
+
+IList* union_sorted(IList *list, IList *other) {
+    return merge_sets(list, other, KEEP_LEFT | KEEP_BOTH | KEEP_RIGHT);
+}
+
+IList* intersect_sorted(IList *list, IList *other) {
+    return merge_sets(list, other, KEEP_BOTH);
+}
+
+IList* difference_sorted(IList *list, IList *other) {
+    return merge_sets(list, other, KEEP_LEFT);
+}
+
+IList* symmetric_difference_sorted(IList *list, IList *other) {
+    return merge_sets(list, other, KEEP_LEFT | KEEP_RIGHT);
+}
+
+IList* union_sorted_move(IList *list, IList *other) {
+    return splice_sets(list, other, KEEP_LEFT | KEEP_BOTH | KEEP_RIGHT);
+}
+
+IList* intersect_sorted_move(IList *list, IList *other) {
+    return splice_sets(list, other, KEEP_BOTH);
+}
+
+IList* difference_sorted_move(IList *list, IList *other) {
+    return splice_sets(list, other, KEEP_LEFT);
+}
+
+IList* symmetric_difference_sorted_move(IList *list, IList *other) {
+    return splice_sets(list, other, KEEP_LEFT | KEEP_RIGHT);
+}
+
+IList* attach_index(IList *list) {
+    if (!list->index) {
+        list->index = new_list_index();
+        index_rebuild(list->index, list);
+    }
+    return list;
+}
+
+IList* detach_index(IList *list) {
+    if (list->index) {
+        delete_list_index(&list->index);
+    }
+    return list;
+}
+
+IList* attach_aggregates(IList *list) {
+    if (!list->aggregates) {
+        list->aggregates = new_list_aggregates();
+        aggregates_rebuild(list->aggregates, list);
+    }
+    return list;
+}
+
+IList* detach_aggregates(IList *list) {
+    if (list->aggregates) {
+        delete_list_aggregates(&list->aggregates);
+    }
+    return list;
+}
+
+IList* invalidate_aggregates(IList *list) {
+    tracked_invalidate(list);
+    return list;
+}
@@ -4,19 +4,55 @@
 typedef int (*i_func)(int);
 typedef int (*i_bifunc)(int, int);
 
-/* Integer Linked List */
+/* Callbacks that receive the context pointer given to the _ctx variant
+    of a function, so that they can use state without globals. */
+typedef int (*i_func_ctx)(int, void*);
+typedef int (*i_bifunc_ctx)(int, int, void*);
+
+/* Integer Linked List
+
+    Lists built from a known number of elements (list_of, the ranges, generate_n,
+    repeat and from_array) allocate all of their nodes in one block, which is
+    private to the list and freed with it. Lists derived from a list (take,
+    filter, split_at, ...) allocate their own nodes, unless the list was put
+    in a pool with empty_list_in or clone_in; then they draw from that pool
+    too, and lists that share it must be used from a single thread. */
+
+typedef struct NodePool NodePool;
+typedef struct ListIndex ListIndex;
+typedef struct ListAggregates ListAggregates;
 
 typedef struct Node {
     int value;
     struct Node *next;
 } Node;
 
+/* Per-list counters of an instrumented build (see istats.h). */
+typedef struct {
+    long long allocs;
+    long long frees;
+    long long steps;
+} IListCounters;
+
 typedef struct {
     Node *first;
     Node *last;
     int size;
+    NodePool *pool;
+    ListIndex *index;
+    ListAggregates *aggregates;
+#ifdef ILIST_INSTRUMENT
+    IListCounters counters;
+#endif
 } IList;
 
+/* Reads the values of a list in blocks (see list_blocks). */
+typedef struct {
+    Node *next;
+    int *buf;
+    int cap;
+} IListBlocks;
+
 /* Returns true if this list contains some elements. */
 extern int is_empty(IList*);
 
@@ -26,6 +62,13 @@ extern int is_not_empty(IList*);
 /* Returns a empty list. */
 extern IList* empty_list();
 
+/* Returns a empty list whose nodes are allocated from the pool. */
+extern IList* empty_list_in(NodePool*);
+
+/* Returns the pool that lists derived from this one allocate from: the pool the
+    list was put in by the caller, or NULL. */
+extern NodePool* derived_pool(IList*);
+
 /* Returns a list containing only the specified object. */
 extern IList* single_list_of();
 
@@ -52,10 +95,16 @@ extern IList* range_step_ex(int, int, int);
     of a function to an initial element. */
 extern IList* generate_n(int, i_func, int);
 
+/* generate_n with a function that receives the context. */
+extern IList* generate_n_ctx(int, i_func_ctx, int, void*);
+
 /* Returns a list produced by iterative application of a function
     to an initial element while the condition is satisfied. */
 extern IList* generate_while(int, i_func, i_func);
 
+/* generate_while with a function and a condition that receive the context. */
+extern IList* generate_while_ctx(int, i_func_ctx, i_func_ctx, void*);
+
 /* Returns a list consisting of n copies of the specified object. */
 extern IList* repeat(int, int);
 
@@ -106,9 +155,15 @@ extern IList* drop_back_n(IList*, int);
 /* [Mutator] Removes first elements from this list while the condition is satisfied. */
 extern IList* drop_while(IList*, i_func);
 
+/* [Mutator] drop_while with a predicate that receives the context. */
+extern IList* drop_while_ctx(IList*, i_func_ctx, void*);
+
 /* [Mutator] Removes last elements from this list while the condition is satisfied. */
 extern IList* drop_back_while(IList*, i_func);
 
+/* [Mutator] drop_back_while with a predicate that receives the context. */
+extern IList* drop_back_while_ctx(IList*, i_func_ctx, void*);
+
 /* [Mutator] Replaces the element at the specified position in this list
     with the specified value. */
 extern IList* update(IList*, int, int);
@@ -122,9 +177,28 @@ extern IList* from_array(int, int*);
 /* Returns an array containing elements of the list. */
 extern int* to_array(IList*);
 
+/* Copies up to cap elements of the list into the buffer and returns their number. */
+extern int to_array_into(IList*, int*, int);
+
+/* [Mutator] Appends the specified count of elements from the array to the end
+    of this list. The new nodes are allocated in one block when the list uses a
+    pool; otherwise each node is allocated on its own. */
+extern IList* append_array(IList*, int, int*);
+
+/* Returns a reader of the values of the list in blocks of up to cap values,
+    which are copied into the buffer of the caller. */
+extern IListBlocks list_blocks(IList*, int*, int);
+
+/* Stores into the pointer the next block of values and returns its length,
+    or 0 after the last block. The list must not change while it is read. */
+extern int list_next_block(IListBlocks*, int**);
+
 /* Performs the given action for each element of the list. */
 extern void foreach(IList*, void (*op)(int));
 
+/* foreach with an action that receives the context. */
+extern void foreach_ctx(IList*, void (*op)(int, void*), void*);
+
 /* Print the list. */
 extern void print_list(IList*);
 
@@ -161,6 +235,12 @@ extern int find_or(IList*, i_func, int);
 /* Finds the first element of the list a negative predicate or returns default value. */
 extern int find_not_or(IList*, i_func, int);
 
+/* find, find_not, find_or and find_not_or with a predicate that receives the context. */
+extern int find_ctx(IList*, i_func_ctx, void*);
+extern int find_not_ctx(IList*, i_func_ctx, void*);
+extern int find_or_ctx(IList*, i_func_ctx, int, void*);
+extern int find_not_or_ctx(IList*, i_func_ctx, int, void*);
+
 /* Returns the index of the first occurrence of the specified element in this list,
     or -1 if this list does not contain the element. */
 extern int index_of(IList*, int);
@@ -169,9 +249,13 @@ extern int index_of(IList*, int);
     or -1 if this list does not contain the element. */
 extern int last_index_of(IList*, int);
 
-/* Returns a copy of this. */
+/* Returns a copy of this. A list built in one block is copied into a new
+    block; a list in a pool made with new_pool is copied into the same pool. */
 extern IList* clone(IList*);
 
+/* Returns a copy of this whose nodes are allocated from the pool. */
+extern IList* clone_in(IList*, NodePool*);
+
 /* Returns a list consisting of the results of applying the given function
     to the elements of this list. */
 extern IList* map(IList*, i_func);
@@ -183,9 +267,35 @@ extern IList* filter(IList*, i_func);
     match the negation given predicate. */
 extern IList* filter_not(IList*, i_func);
 
+/* [Mutator] map with a function that receives the context. */
+extern IList* map_ctx(IList*, i_func_ctx, void*);
+
+/* filter and filter_not with a predicate that receives the context. */
+extern IList* filter_ctx(IList*, i_func_ctx, void*);
+extern IList* filter_not_ctx(IList*, i_func_ctx, void*);
+
 /* [Mutator] Appends all of the elements in the second collection to the end of first list. */
 extern IList* add_all(IList*, IList*);
 
+/* [Mutator] Moves all of the elements of the second list to the end of this list
+    without copying them. The second list becomes empty. */
+extern IList* concat_move(IList*, IList*);
+
+/* [Mutator] Moves all of the elements of the second list into this list before the
+    specified position without copying them. The second list becomes empty. */
+extern IList* splice(IList*, int, IList*);
+
+/* [Mutator] Keeps first n elements in this list and moves the rest into a new list,
+    which is returned. No nodes are copied. */
+extern IList* split_at(IList*, int);
+
+/* [Mutator] Keeps the longest prefix of elements that satisfy a predicate in this list
+    and moves the rest into a new list, which is returned. No nodes are copied. */
+extern IList* split_while(IList*, i_func);
+
+/* [Mutator] split_while with a predicate that receives the context. */
+extern IList* split_while_ctx(IList*, i_func_ctx, void*);
+
 /* Returns true if the list contains the specified element. */
 extern int contains(IList*, int);
 
@@ -201,18 +311,30 @@ extern int fold_right(int, IList*, i_bifunc);
 /* Applies a binary operator to all elements of the list, going right to left. */
 extern int reduce_right(IList*, i_bifunc);
 
+/* The folds and reductions with an operator that receives the context. */
+extern int fold_left_ctx(int, IList*, i_bifunc_ctx, void*);
+extern int reduce_left_ctx(IList*, i_bifunc_ctx, void*);
+extern int fold_right_ctx(int, IList*, i_bifunc_ctx, void*);
+extern int reduce_right_ctx(IList*, i_bifunc_ctx, void*);
+
 /* Selects first n elements. */
 extern IList* take(IList*, int);
 
 /* Takes longest prefix of elements that satisfy a predicate. */
 extern IList* take_while(IList*, i_func);
 
+/* take_while with a predicate that receives the context. */
+extern IList* take_while_ctx(IList*, i_func_ctx, void*);
+
 /* Selects last n elements. */
 extern IList* take_right(IList*, int);
 
 /* Takes longest suffix of elements that satisfy a predicate. */
 extern IList* take_right_while(IList*, i_func);
 
+/* take_right_while with a predicate that receives the context. */
+extern IList* take_right_while_ctx(IList*, i_func_ctx, void*);
+
 /* Returns a list containing the elements greater than or equal to index from extending up
     to index until of the list. */
 extern IList* slice(IList*, int, int);
@@ -226,12 +348,57 @@ extern int exists(IList*, i_func);
 /* Counts the number of elements in the list which satisfy a predicate. */
 extern int count(IList*, i_func);
 
+/* forall, exists and count with a predicate that receives the context. */
+extern int forall_ctx(IList*, i_func_ctx, void*);
+extern int exists_ctx(IList*, i_func_ctx, void*);
+extern int count_ctx(IList*, i_func_ctx, void*);
+
 /* Builds a new list from the list without any duplicate elements. */
 extern IList* unique(IList*);
 
 /* [Mutator] Returns a list consisting only of the distinct elements (according to ==). */
 extern IList* distinct(IList*);
 
+/* [Mutator] Keeps the elements that match the predicate and frees the others, in one pass. */
+extern IList* retain_if(IList*, i_func);
+
+/* [Mutator] Frees the elements that match the predicate, in one pass. */
+extern IList* remove_if(IList*, i_func);
+
+/* [Mutator] retain_if and remove_if with a predicate that receives the context. */
+extern IList* retain_if_ctx(IList*, i_func_ctx, void*);
+extern IList* remove_if_ctx(IList*, i_func_ctx, void*);
+
+/* [Mutator] Removes each element that equals the one before it. */
+extern IList* dedup_adjacent(IList*);
+
+/* [Mutator] Keeps the elements that match the predicate and moves the others,
+    without copying, to the returned list. Both keep their order. */
+extern IList* partition(IList*, i_func);
+
+/* [Mutator] partition with a predicate that receives the context. */
+extern IList* partition_ctx(IList*, i_func_ctx, void*);
+
+/* [Mutator] Replaces the elements of the second list with the results of the function
+    applied to the elements of the first one, reusing its nodes. The lists may be the same. */
+extern IList* map_into(IList*, i_func, IList*);
+
+/* [Mutator] map_into with a function that receives the context. */
+extern IList* map_into_ctx(IList*, i_func_ctx, void*, IList*);
+
+/* Builds a new list of the distinct elements of both lists, in order of first occurrence. */
+extern IList* union_unsorted(IList*, IList*);
+
+/* Builds a new list of the distinct elements of this list that the second list contains. */
+extern IList* intersect_unsorted(IList*, IList*);
+
+/* Builds a new list of the distinct elements of this list that the second list does not contain. */
+extern IList* difference_unsorted(IList*, IList*);
+
+/* Builds a new list of the distinct elements of either list that the other list does not
+    contain: those of this list first, then those of the second list. */
+extern IList* symmetric_difference_unsorted(IList*, IList*);
+
 /* [Mutator] Swap values of two elements in the list. */
 extern IList* swap(IList*, int, int);
 
@@ -244,6 +411,14 @@ extern int is_suffix(IList*, IList*);
 /* Returns true iff the first list is a sublist of the second. */
 extern int is_sublist(IList*, IList*);
 
+/* Returns the index of the first occurrence of the second list in the first one,
+    or -1 if the first list does not contain it. */
+extern int find_sublist(IList*, IList*);
+
+/* Returns a list of the indexes of all (possibly overlapping) occurrences
+    of the second list in the first one. */
+extern IList* find_all_sublists(IList*, IList*);
+
 /* Returns a new list containing elements that `interspersed`
     by the element between the elements of the list. */
 extern IList* intersperse(IList*, int);
@@ -257,4 +432,90 @@ extern int min(IList*);
 /* Sums up the elements of the list. */
 extern int sum(IList*);
 
+/* Sums up the elements of the list into a 64-bit accumulator. */
+extern long long sum64(IList*);
+
+/* [Mutator] Sorts this list in ascending order (stable merge sort, no allocation). */
+extern IList* sort(IList*);
+
+/* [Mutator] Sorts this list with a comparator that returns a negative number, zero
+    or a positive number as the first argument is less than, equal to or greater than
+    the second (stable merge sort, no allocation). */
+extern IList* sort_by(IList*, i_bifunc);
+
+/* [Mutator] sort_by with a comparator that receives the context. */
+extern IList* sort_by_ctx(IList*, i_bifunc_ctx, void*);
+
+/* [Mutator] Sorts this list in ascending order (LSD radix sort, no allocation). */
+extern IList* radix_sort(IList*);
+
+/* Returns true if the elements of the list are in ascending order. */
+extern int is_sorted(IList*);
+
+/* Returns true if the elements of the list are in order according to the comparator. */
+extern int is_sorted_by(IList*, i_bifunc);
+
+/* is_sorted_by with a comparator that receives the context. */
+extern int is_sorted_by_ctx(IList*, i_bifunc_ctx, void*);
+
+/* [Mutator] Inserts the element into this sorted list after all elements equal to it. */
+extern IList* insert_sorted(IList*, int);
+
+/* [Mutator] Moves all elements of the second sorted list into this sorted list,
+    keeping it sorted. The second list becomes empty. */
+extern IList* merge_sorted(IList*, IList*);
+
+/* Set operations on sorted lists. Each runs in one linear pass over both lists
+    and yields a sorted list where every element occurs once. */
+
+/* Builds a new list of the elements of either list. */
+extern IList* union_sorted(IList*, IList*);
+
+/* Builds a new list of the elements of both lists. */
+extern IList* intersect_sorted(IList*, IList*);
+
+/* Builds a new list of the elements of this list that are not in the second list. */
+extern IList* difference_sorted(IList*, IList*);
+
+/* Builds a new list of the elements that are in exactly one of the lists. */
+extern IList* symmetric_difference_sorted(IList*, IList*);
+
+/* [Mutator] Same as union_sorted, but relinks the nodes of both lists into this list
+    and frees the unused ones. The second list becomes empty. */
+extern IList* union_sorted_move(IList*, IList*);
+
+/* [Mutator] Same as intersect_sorted, but relinks the nodes of both lists into this list
+    and frees the unused ones. The second list becomes empty. */
+extern IList* intersect_sorted_move(IList*, IList*);
+
+/* [Mutator] Same as difference_sorted, but relinks the nodes of both lists into this list
+    and frees the unused ones. The second list becomes empty. */
+extern IList* difference_sorted_move(IList*, IList*);
+
+/* [Mutator] Same as symmetric_difference_sorted, but relinks the nodes of both lists
+    into this list and frees the unused ones. The second list becomes empty. */
+extern IList* symmetric_difference_sorted_move(IList*, IList*);
+
+/* [Mutator] Attaches a positional index to this list, built in one pass. Lookups by
+    position (get, update, insert, delete, swap, drop_back) then take about O(sqrt n)
+    steps, or O(1) when close to the previous lookup. Mutators keep the index up to date. */
+extern IList* attach_index(IList*);
+
+/* [Mutator] Detaches the positional index from this list and deletes it. */
+extern IList* detach_index(IList*);
+
+/* [Mutator] Starts tracking the sum, minimum, maximum and order of this list, built in
+    one pass. push, push_back, pop, drop, insert, delete, update and map keep them up to
+    date, so sum, sum64, min, max and is_sorted take O(1) and contains can reject values
+    outside the range. Removing the current minimum or maximum, and changes that move
+    many nodes at once, make the next query rebuild them in one pass. */
+extern IList* attach_aggregates(IList*);
+
+/* [Mutator] Stops tracking the aggregates of this list. */
+extern IList* detach_aggregates(IList*);
+
+/* [Mutator] Marks the tracked aggregates of this list for rebuild. Call it after
+    changing values through the nodes directly. */
+extern IList* invalidate_aggregates(IList*);
+
 #endif
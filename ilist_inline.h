@@ -0,0 +1,180 @@
+#ifndef ILIST_INLINE_H_
+#define ILIST_INLINE_H_
+
+#include "ilist.h"
+
+/* Inline Mode for IList
+
+    Including this header instead of ilist.h replaces calls to the accessors
+    and the traversal functions below with static inline definitions, so the
+    compiler can inline them into the caller, and a callback passed as a
+    constant into the loop. Other functions, and taking the address of any
+    function, still use the library. The replaced names are function-like
+    macros, so a variable named count or max is not affected. Lists with
+    tracked aggregates are passed on to the library for the functions that
+    use or update them.
+
+    Do not include this header in the library itself. */
+
+static inline int inline_is_empty(IList *list) {
+    return list->size == 0;
+}
+
+static inline int inline_is_not_empty(IList *list) {
+    return list->size != 0;
+}
+
+static inline int inline_get_size(IList *list) {
+    return list->size;
+}
+
+static inline int inline_get_first(IList *list) {
+    return list->first->value;
+}
+
+static inline int inline_get_last(IList *list) {
+    return list->last->value;
+}
+
+static inline int inline_contains(IList *list, int value) {
+    if (list->aggregates) {
+        return contains(list, value);
+    }
+    for (Node *cur = list->first; cur; cur = cur->next) {
+        if (cur->value == value) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static inline int inline_index_of(IList *list, int item) {
+    int index = 0;
+    for (Node *cur = list->first; cur; cur = cur->next) {
+        if (item == cur->value) {
+            return index;
+        }
+        index++;
+    }
+    return -1;
+}
+
+static inline void inline_foreach(IList *list, void (*op)(int)) {
+    for (Node *cur = list->first; cur; cur = cur->next) {
+        op(cur->value);
+    }
+}
+
+static inline IList* inline_map(IList *list, i_func op) {
+    if (list->aggregates) {
+        return map(list, op);
+    }
+    for (Node *cur = list->first; cur; cur = cur->next) {
+        cur->value = op(cur->value);
+    }
+    return list;
+}
+
+static inline int inline_fold_left(int init, IList *list, i_bifunc op) {
+    int acc = init;
+    for (Node *cur = list->first; cur; cur = cur->next) {
+        acc = op(acc, cur->value);
+    }
+    return acc;
+}
+
+static inline int inline_forall(IList *list, i_func pred) {
+    for (Node *cur = list->first; cur; cur = cur->next) {
+        if (!pred(cur->value)) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static inline int inline_exists(IList *list, i_func pred) {
+    for (Node *cur = list->first; cur; cur = cur->next) {
+        if (pred(cur->value)) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static inline int inline_count(IList *list, i_func pred) {
+    int count = 0;
+    for (Node *cur = list->first; cur; cur = cur->next) {
+        if (pred(cur->value)) {
+            count++;
+        }
+    }
+    return count;
+}
+
+static inline int inline_max(IList *list) {
+    if (list->aggregates) {
+        return max(list);
+    }
+    int max = list->first->value;
+    for (Node *cur = list->first; cur; cur = cur->next) {
+        if (cur->value > max) {
+            max = cur->value;
+        }
+    }
+    return max;
+}
+
+static inline int inline_min(IList *list) {
+    if (list->aggregates) {
+        return min(list);
+    }
+    int min = list->first->value;
+    for (Node *cur = list->first; cur; cur = cur->next) {
+        if (cur->value < min) {
+            min = cur->value;
+        }
+    }
+    return min;
+}
+
+static inline int inline_sum(IList *list) {
+    if (list->aggregates) {
+        return sum(list);
+    }
+    unsigned sum = 0;
+    for (Node *cur = list->first; cur; cur = cur->next) {
+        sum += (unsigned) cur->value;
+    }
+    return (int) sum;
+}
+
+static inline long long inline_sum64(IList *list) {
+    if (list->aggregates) {
+        return sum64(list);
+    }
+    long long sum = 0;
+    for (Node *cur = list->first; cur; cur = cur->next) {
+        sum += cur->value;
+    }
+    return sum;
+}
+
+#define is_empty(list) inline_is_empty(list)
+#define is_not_empty(list) inline_is_not_empty(list)
+#define get_size(list) inline_get_size(list)
+#define get_first(list) inline_get_first(list)
+#define get_last(list) inline_get_last(list)
+#define contains(list, value) inline_contains(list, value)
+#define index_of(list, item) inline_index_of(list, item)
+#define foreach(list, op) inline_foreach(list, op)
+#define map(list, op) inline_map(list, op)
+#define fold_left(init, list, op) inline_fold_left(init, list, op)
+#define forall(list, pred) inline_forall(list, pred)
+#define exists(list, pred) inline_exists(list, pred)
+#define count(list, pred) inline_count(list, pred)
+#define max(list) inline_max(list)
+#define min(list) inline_min(list)
+#define sum(list) inline_sum(list)
+#define sum64(list) inline_sum64(list)
+
+#endif
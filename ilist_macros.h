@@ -0,0 +1,113 @@
+#ifndef ILIST_MACROS_H_
+#define ILIST_MACROS_H_
+
+#include "ilist.h"
+
+/* Inlinable Loops
+
+    Statement macros for the higher-order functions of IList. The callback
+    is written as an expression over a named element (and accumulator),
+    so the compiler sees it inside the loop and can inline and vectorize
+    it, and it can use any local variable without a context pointer.
+
+        int n;
+        LIST_COUNT(n, list, x, x > limit);
+        LIST_MAP(list, x, x * factor);
+
+    The element name is declared by the macro. The expression comes last
+    and may contain commas. Arguments other than the expression are
+    evaluated once. */
+
+/* Runs the statement for each element of the list. */
+#define LIST_FOREACH(list, x, ...) do { \
+    for (Node *node_ = (list)->first; node_; node_ = node_->next) { \
+        int x = node_->value; \
+        __VA_ARGS__; \
+    } \
+} while (0)
+
+/* [Mutator] Replaces each element of the list with the value of the expression. */
+#define LIST_MAP(list, x, ...) do { \
+    IList *map_ = (list); \
+    for (Node *node_ = map_->first; node_; node_ = node_->next) { \
+        int x = node_->value; \
+        node_->value = (__VA_ARGS__); \
+    } \
+    invalidate_aggregates(map_); \
+} while (0)
+
+/* Stores into result a new list of the elements for which the expression holds. */
+#define LIST_FILTER(result, list, x, ...) do { \
+    IList *src_ = (list); \
+    IList *out_ = empty_list_in(derived_pool(src_)); \
+    for (Node *node_ = src_->first; node_; node_ = node_->next) { \
+        int x = node_->value; \
+        if (__VA_ARGS__) { \
+            push_back(out_, x); \
+        } \
+    } \
+    (result) = out_; \
+} while (0)
+
+/* Stores into result the number of elements for which the expression holds. */
+#define LIST_COUNT(result, list, x, ...) do { \
+    int count_ = 0; \
+    for (Node *node_ = (list)->first; node_; node_ = node_->next) { \
+        int x = node_->value; \
+        count_ += (__VA_ARGS__) ? 1 : 0; \
+    } \
+    (result) = count_; \
+} while (0)
+
+/* Stores into result the fold of the list from init, going left to right;
+    the expression gives the next accumulator from acc and x. */
+#define LIST_FOLD_LEFT(result, init, list, acc, x, ...) do { \
+    int acc = (init); \
+    for (Node *node_ = (list)->first; node_; node_ = node_->next) { \
+        int x = node_->value; \
+        acc = (__VA_ARGS__); \
+    } \
+    (result) = acc; \
+} while (0)
+
+/* Stores into result the first element for which the expression holds,
+    or the default value if there is none. */
+#define LIST_FIND_OR(result, list, default_value, x, ...) do { \
+    int found_ = (default_value); \
+    for (Node *node_ = (list)->first; node_; node_ = node_->next) { \
+        int x = node_->value; \
+        if (__VA_ARGS__) { \
+            found_ = x; \
+            break; \
+        } \
+    } \
+    (result) = found_; \
+} while (0)
+
+/* Stores into result whether the expression holds for every element. */
+#define LIST_FORALL(result, list, x, ...) do { \
+    int all_ = 1; \
+    for (Node *node_ = (list)->first; node_; node_ = node_->next) { \
+        int x = node_->value; \
+        if (!(__VA_ARGS__)) { \
+            all_ = 0; \
+            break; \
+        } \
+    } \
+    (result) = all_; \
+} while (0)
+
+/* Stores into result whether the expression holds for some element. */
+#define LIST_EXISTS(result, list, x, ...) do { \
+    int any_ = 0; \
+    for (Node *node_ = (list)->first; node_; node_ = node_->next) { \
+        int x = node_->value; \
+        if (__VA_ARGS__) { \
+            any_ = 1; \
+            break; \
+        } \
+    } \
+    (result) = any_; \
+} while (0)
+
+#endif
@@ -0,0 +1,348 @@
+#include <stdlib.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include "ipar.h"
+
+typedef struct {
+    void (*fn)(void*);
+    void *arg;
+} Task;
+
+struct ThreadPool {
+    pthread_t *workers;
+    int size;
+    pthread_mutex_t batch_lock;
+    pthread_mutex_t lock;
+    pthread_cond_t has_work;
+    pthread_cond_t done;
+    Task *tasks;
+    int next;
+    int count;
+    int pending;
+    int shutdown;
+};
+
+/* A contiguous part of a list processed by one task. */
+typedef struct {
+    Node *start;
+    int length;
+    i_func fn;
+    i_bifunc op;
+    i_func_ctx fn_ctx;
+    i_bifunc_ctx op_ctx;
+    void *ctx;
+    int result;
+    IList *out;
+    atomic_int *stop;
+} Part;
+
+/* Calls the part's function, passing the context if it takes one. */
+static inline int apply(Part *part, int x) {
+    return part->fn ? part->fn(x) : part->fn_ctx(x, part->ctx);
+}
+
+static inline int combine(Part *part, int x, int y) {
+    return part->op ? part->op(x, y) : part->op_ctx(x, y, part->ctx);
+}
+
+static void* worker(void *arg) {
+    ThreadPool *pool = (ThreadPool*) arg;
+    pthread_mutex_lock(&pool->lock);
+    while (1) {
+        while (!pool->shutdown && pool->next == pool->count) {
+            pthread_cond_wait(&pool->has_work, &pool->lock);
+        }
+        if (pool->shutdown) {
+            break;
+        }
+        Task task = pool->tasks[pool->next++];
+        pthread_mutex_unlock(&pool->lock);
+        task.fn(task.arg);
+        pthread_mutex_lock(&pool->lock);
+        if (--pool->pending == 0) {
+            pthread_cond_signal(&pool->done);
+        }
+    }
+    pthread_mutex_unlock(&pool->lock);
+    return NULL;
+}
+
+/* Runs the tasks on the workers and waits for all of them to finish. */
+static void run_batch(ThreadPool *pool, Task *tasks, int count) {
+    pthread_mutex_lock(&pool->batch_lock);
+    pthread_mutex_lock(&pool->lock);
+    pool->tasks = tasks;
+    pool->next = 0;
+    pool->count = count;
+    pool->pending = count;
+    pthread_cond_broadcast(&pool->has_work);
+    while (pool->pending > 0) {
+        pthread_cond_wait(&pool->done, &pool->lock);
+    }
+    pool->tasks = NULL;
+    pool->next = 0;
+    pool->count = 0;
+    pthread_mutex_unlock(&pool->lock);
+    pthread_mutex_unlock(&pool->batch_lock);
+}
+
+/* Splits the list into at most the specified number of parts of nearly equal length. */
+static Part* split(IList *list, ThreadPool *pool, int threads, int *count) {
+    int parts = threads > 0 ? threads : pool->size;
+    if (parts > list->size) {
+        parts = list->size;
+    }
+    if (parts < 1) {
+        parts = 1;
+    }
+    Part *result = (Part*) calloc(parts, sizeof(Part));
+    Node *cur = list->first;
+    for (int i = 0; i < parts; i++) {
+        result[i].start = cur;
+        result[i].length = list->size / parts + (i < list->size % parts ? 1 : 0);
+        for (int j = 0; j < result[i].length; j++) {
+            cur = cur->next;
+        }
+    }
+    *count = parts;
+    return result;
+}
+
+static void run_parts(ThreadPool *pool, Part *parts, int count, void (*fn)(void*)) {
+    Task *tasks = (Task*) malloc(count * sizeof(Task));
+    for (int i = 0; i < count; i++) {
+        tasks[i].fn = fn;
+        tasks[i].arg = &parts[i];
+    }
+    run_batch(pool, tasks, count);
+    free(tasks);
+}
+
+ThreadPool* new_thread_pool(int size) {
+    ThreadPool *pool = (ThreadPool*) calloc(1, sizeof(ThreadPool));
+    pool->size = size > 0 ? size : 1;
+    pthread_mutex_init(&pool->batch_lock, NULL);
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->has_work, NULL);
+    pthread_cond_init(&pool->done, NULL);
+    pool->workers = (pthread_t*) malloc(pool->size * sizeof(pthread_t));
+    for (int i = 0; i < pool->size; i++) {
+        pthread_create(&pool->workers[i], NULL, worker, pool);
+    }
+    return pool;
+}
+
+void delete_thread_pool(ThreadPool **pool) {
+    pthread_mutex_lock(&(*pool)->lock);
+    (*pool)->shutdown = 1;
+    pthread_cond_broadcast(&(*pool)->has_work);
+    pthread_mutex_unlock(&(*pool)->lock);
+    for (int i = 0; i < (*pool)->size; i++) {
+        pthread_join((*pool)->workers[i], NULL);
+    }
+    pthread_mutex_destroy(&(*pool)->batch_lock);
+    pthread_mutex_destroy(&(*pool)->lock);
+    pthread_cond_destroy(&(*pool)->has_work);
+    pthread_cond_destroy(&(*pool)->done);
+    free((*pool)->workers);
+    free(*pool);
+    *pool = NULL;
+}
+
+int thread_pool_size(ThreadPool *pool) {
+    return pool->size;
+}
+
+static void map_part(void *arg) {
+    Part *part = (Part*) arg;
+    Node *cur = part->start;
+    for (int i = 0; i < part->length; i++, cur = cur->next) {
+        cur->value = apply(part, cur->value);
+    }
+}
+
+/* Copies the callbacks of the template into every part. */
+static void set_callbacks(Part *parts, int count, Part fns) {
+    for (int i = 0; i < count; i++) {
+        parts[i].fn = fns.fn;
+        parts[i].op = fns.op;
+        parts[i].fn_ctx = fns.fn_ctx;
+        parts[i].op_ctx = fns.op_ctx;
+        parts[i].ctx = fns.ctx;
+    }
+}
+
+static IList* map_parts(IList *list, Part fns, ThreadPool *pool, int threads) {
+    int count;
+    Part *parts = split(list, pool, threads, &count);
+    set_callbacks(parts, count, fns);
+    run_parts(pool, parts, count, map_part);
+    free(parts);
+    return invalidate_aggregates(list);
+}
+
+static void filter_part(void *arg) {
+    Part *part = (Part*) arg;
+    Node *cur = part->start;
+    for (int i = 0; i < part->length; i++, cur = cur->next) {
+        if (apply(part, cur->value)) {
+            push_back(part->out, cur->value);
+        }
+    }
+}
+
+IList* par_map(IList *list, i_func op, ThreadPool *pool, int threads) {
+    return map_parts(list, (Part) { .fn = op }, pool, threads);
+}
+
+IList* par_map_ctx(IList *list, i_func_ctx op, void *ctx, ThreadPool *pool, int threads) {
+    return map_parts(list, (Part) { .fn_ctx = op, .ctx = ctx }, pool, threads);
+}
+
+static IList* filter_parts(IList *list, Part fns, ThreadPool *pool, int threads) {
+    int count;
+    Part *parts = split(list, pool, threads, &count);
+    set_callbacks(parts, count, fns);
+    for (int i = 0; i < count; i++) {
+        parts[i].out = empty_list();
+    }
+    run_parts(pool, parts, count, filter_part);
+    IList *result = parts[0].out;
+    for (int i = 1; i < count; i++) {
+        IList *out = parts[i].out;
+        if (is_not_empty(out)) {
+            if (is_empty(result)) {
+                result->first = out->first;
+            } else {
+                result->last->next = out->first;
+            }
+            result->last = out->last;
+            result->size += out->size;
+        }
+        free(out);
+    }
+    free(parts);
+    return result;
+}
+
+IList* par_filter(IList *list, i_func pred, ThreadPool *pool, int threads) {
+    return filter_parts(list, (Part) { .fn = pred }, pool, threads);
+}
+
+IList* par_filter_ctx(IList *list, i_func_ctx pred, void *ctx, ThreadPool *pool, int threads) {
+    return filter_parts(list, (Part) { .fn_ctx = pred, .ctx = ctx }, pool, threads);
+}
+
+static void fold_part(void *arg) {
+    Part *part = (Part*) arg;
+    Node *cur = part->start;
+    int acc = cur->value;
+    for (int i = 1; i < part->length; i++) {
+        cur = cur->next;
+        acc = combine(part, acc, cur->value);
+    }
+    part->result = acc;
+}
+
+static int fold_parts(int init, IList *list, Part fns, ThreadPool *pool, int threads) {
+    if (is_empty(list)) {
+        return init;
+    }
+    int count;
+    Part *parts = split(list, pool, threads, &count);
+    set_callbacks(parts, count, fns);
+    run_parts(pool, parts, count, fold_part);
+    int acc = init;
+    for (int i = 0; i < count; i++) {
+        acc = combine(&fns, acc, parts[i].result);
+    }
+    free(parts);
+    return acc;
+}
+
+int par_fold_left(int init, IList *list, i_bifunc op, ThreadPool *pool, int threads) {
+    return fold_parts(init, list, (Part) { .op = op }, pool, threads);
+}
+
+int par_fold_left_ctx(int init, IList *list, i_bifunc_ctx op, void *ctx, ThreadPool *pool, int threads) {
+    return fold_parts(init, list, (Part) { .op_ctx = op, .ctx = ctx }, pool, threads);
+}
+
+static void count_part(void *arg) {
+    Part *part = (Part*) arg;
+    Node *cur = part->start;
+    int count = 0;
+    for (int i = 0; i < part->length; i++, cur = cur->next) {
+        if (apply(part, cur->value)) {
+            count++;
+        }
+    }
+    part->result = count;
+}
+
+static int count_parts(IList *list, Part fns, ThreadPool *pool, int threads) {
+    int count;
+    Part *parts = split(list, pool, threads, &count);
+    set_callbacks(parts, count, fns);
+    run_parts(pool, parts, count, count_part);
+    int result = 0;
+    for (int i = 0; i < count; i++) {
+        result += parts[i].result;
+    }
+    free(parts);
+    return result;
+}
+
+int par_count(IList *list, i_func pred, ThreadPool *pool, int threads) {
+    return count_parts(list, (Part) { .fn = pred }, pool, threads);
+}
+
+int par_count_ctx(IList *list, i_func_ctx pred, void *ctx, ThreadPool *pool, int threads) {
+    return count_parts(list, (Part) { .fn_ctx = pred, .ctx = ctx }, pool, threads);
+}
+
+/* Sets the shared stop flag when the predicate equals part->result for some element. */
+static void search_part(void *arg) {
+    Part *part = (Part*) arg;
+    Node *cur = part->start;
+    for (int i = 0; i < part->length; i++, cur = cur->next) {
+        if (atomic_load_explicit(part->stop, memory_order_relaxed)) {
+            return;
+        }
+        if (!apply(part, cur->value) == !part->result) {
+            atomic_store(part->stop, 1);
+            return;
+        }
+    }
+}
+
+static int par_search(IList *list, Part fns, int wanted, ThreadPool *pool, int threads) {
+    atomic_int stop;
+    atomic_init(&stop, 0);
+    int count;
+    Part *parts = split(list, pool, threads, &count);
+    set_callbacks(parts, count, fns);
+    for (int i = 0; i < count; i++) {
+        parts[i].result = wanted;
+        parts[i].stop = &stop;
+    }
+    run_parts(pool, parts, count, search_part);
+    free(parts);
+    return atomic_load(&stop);
+}
+
+int par_forall(IList *list, i_func pred, ThreadPool *pool, int threads) {
+    return !par_search(list, (Part) { .fn = pred }, 0, pool, threads);
+}
+
+int par_exists(IList *list, i_func pred, ThreadPool *pool, int threads) {
+    return par_search(list, (Part) { .fn = pred }, 1, pool, threads);
+}
+
+int par_forall_ctx(IList *list, i_func_ctx pred, void *ctx, ThreadPool *pool, int threads) {
+    return !par_search(list, (Part) { .fn_ctx = pred, .ctx = ctx }, 0, pool, threads);
+}
+
+int par_exists_ctx(IList *list, i_func_ctx pred, void *ctx, ThreadPool *pool, int threads) {
+    return par_search(list, (Part) { .fn_ctx = pred, .ctx = ctx }, 1, pool, threads);
+}
@@ -0,0 +1,66 @@
+#ifndef IPAR_H_
+#define IPAR_H_
+
+#include "ilist.h"
+
+/* Parallel list operations on a reusable worker pool (POSIX threads).
+
+    Each operation splits the list into as many contiguous parts as the
+    specified thread count (0 means the pool size) and runs one part per
+    worker. Callbacks are called concurrently and must be thread-safe.
+
+    The _ctx variants pass the same context pointer to every call of the
+    callback; the context is shared by all workers. */
+
+typedef struct ThreadPool ThreadPool;
+
+/* Returns a pool with the specified number of worker threads. */
+extern ThreadPool* new_thread_pool(int);
+
+/* Stops the workers and deletes the pool. */
+extern void delete_thread_pool(ThreadPool**);
+
+/* Returns the number of worker threads of the pool. */
+extern int thread_pool_size(ThreadPool*);
+
+/* [Mutator] Applies the given function to the elements of this list in parallel. */
+extern IList* par_map(IList*, i_func, ThreadPool*, int);
+
+/* Returns a list consisting of the elements of this list that match the given predicate,
+    in their original order. The predicate is evaluated in parallel. */
+extern IList* par_filter(IList*, i_func, ThreadPool*, int);
+
+/* Applies an associative binary operator to a start value and all elements of the list.
+    Parts are folded in parallel and their results are combined left to right. */
+extern int par_fold_left(int, IList*, i_bifunc, ThreadPool*, int);
+
+/* Counts the number of elements in the list which satisfy a predicate, in parallel. */
+extern int par_count(IList*, i_func, ThreadPool*, int);
+
+/* Tests whether a predicate holds for all elements of the list, in parallel.
+    Stops all workers as soon as one element fails. */
+extern int par_forall(IList*, i_func, ThreadPool*, int);
+
+/* Tests whether a predicate holds for at least one element of the list, in parallel.
+    Stops all workers as soon as one element matches. */
+extern int par_exists(IList*, i_func, ThreadPool*, int);
+
+/* [Mutator] par_map with a callback that receives the context. */
+extern IList* par_map_ctx(IList*, i_func_ctx, void*, ThreadPool*, int);
+
+/* par_filter with a predicate that receives the context. */
+extern IList* par_filter_ctx(IList*, i_func_ctx, void*, ThreadPool*, int);
+
+/* par_fold_left with an operator that receives the context. */
+extern int par_fold_left_ctx(int, IList*, i_bifunc_ctx, void*, ThreadPool*, int);
+
+/* par_count with a predicate that receives the context. */
+extern int par_count_ctx(IList*, i_func_ctx, void*, ThreadPool*, int);
+
+/* par_forall with a predicate that receives the context. */
+extern int par_forall_ctx(IList*, i_func_ctx, void*, ThreadPool*, int);
+
+/* par_exists with a predicate that receives the context. */
+extern int par_exists_ctx(IList*, i_func_ctx, void*, ThreadPool*, int);
+
+#endif
@@ -0,0 +1,399 @@
+#include <stddef.h>
+#include <stdatomic.h>
+#include "ireduce.h"
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define REDUCE_X86 1
+#include <immintrin.h>
+#endif
+
+typedef struct {
+    const char *isa;
+    int (*sum)(int, int*);
+    long long (*sum64)(int, int*);
+    int (*max)(int, int*);
+    int (*min)(int, int*);
+    int (*count)(int, int*, int);
+    int (*index_of)(int, int*, int);
+    int (*last_index_of)(int, int*, int);
+} Kernels;
+
+/* Scalar */
+
+static int sum_scalar(int n, int *arr) {
+    unsigned sum = 0;
+    for (int i = 0; i < n; i++) {
+        sum += (unsigned) arr[i];
+    }
+    return (int) sum;
+}
+
+static long long sum64_scalar(int n, int *arr) {
+    long long sum = 0;
+    for (int i = 0; i < n; i++) {
+        sum += arr[i];
+    }
+    return sum;
+}
+
+static int max_scalar(int n, int *arr) {
+    int max = arr[0];
+    for (int i = 1; i < n; i++) {
+        if (arr[i] > max) {
+            max = arr[i];
+        }
+    }
+    return max;
+}
+
+static int min_scalar(int n, int *arr) {
+    int min = arr[0];
+    for (int i = 1; i < n; i++) {
+        if (arr[i] < min) {
+            min = arr[i];
+        }
+    }
+    return min;
+}
+
+static int count_scalar(int n, int *arr, int item) {
+    int count = 0;
+    for (int i = 0; i < n; i++) {
+        count += arr[i] == item;
+    }
+    return count;
+}
+
+static int index_of_scalar(int n, int *arr, int item) {
+    for (int i = 0; i < n; i++) {
+        if (arr[i] == item) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static int last_index_of_scalar(int n, int *arr, int item) {
+    for (int i = n - 1; i >= 0; i--) {
+        if (arr[i] == item) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static const Kernels scalar_kernels = {
+    "scalar", sum_scalar, sum64_scalar, max_scalar, min_scalar,
+    count_scalar, index_of_scalar, last_index_of_scalar
+};
+
+#ifdef REDUCE_X86
+
+/* SSE4.1 */
+
+__attribute__((target("sse4.1")))
+static int sum_sse41(int n, int *arr) {
+    __m128i acc = _mm_setzero_si128();
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        acc = _mm_add_epi32(acc, _mm_loadu_si128((__m128i*) (arr + i)));
+    }
+    int lanes[4];
+    _mm_storeu_si128((__m128i*) lanes, acc);
+    return (int) ((unsigned) sum_scalar(4, lanes) + (unsigned) sum_scalar(n - i, arr + i));
+}
+
+__attribute__((target("sse4.1")))
+static long long sum64_sse41(int n, int *arr) {
+    __m128i acc = _mm_setzero_si128();
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i v = _mm_loadu_si128((__m128i*) (arr + i));
+        acc = _mm_add_epi64(acc, _mm_cvtepi32_epi64(v));
+        acc = _mm_add_epi64(acc, _mm_cvtepi32_epi64(_mm_srli_si128(v, 8)));
+    }
+    long long lanes[2];
+    _mm_storeu_si128((__m128i*) lanes, acc);
+    return lanes[0] + lanes[1] + sum64_scalar(n - i, arr + i);
+}
+
+__attribute__((target("sse4.1")))
+static int max_sse41(int n, int *arr) {
+    if (n < 4) {
+        return max_scalar(n, arr);
+    }
+    __m128i acc = _mm_loadu_si128((__m128i*) arr);
+    int i = 4;
+    for (; i + 4 <= n; i += 4) {
+        acc = _mm_max_epi32(acc, _mm_loadu_si128((__m128i*) (arr + i)));
+    }
+    int lanes[4];
+    _mm_storeu_si128((__m128i*) lanes, acc);
+    int max = max_scalar(4, lanes);
+    for (; i < n; i++) {
+        if (arr[i] > max) {
+            max = arr[i];
+        }
+    }
+    return max;
+}
+
+__attribute__((target("sse4.1")))
+static int min_sse41(int n, int *arr) {
+    if (n < 4) {
+        return min_scalar(n, arr);
+    }
+    __m128i acc = _mm_loadu_si128((__m128i*) arr);
+    int i = 4;
+    for (; i + 4 <= n; i += 4) {
+        acc = _mm_min_epi32(acc, _mm_loadu_si128((__m128i*) (arr + i)));
+    }
+    int lanes[4];
+    _mm_storeu_si128((__m128i*) lanes, acc);
+    int min = min_scalar(4, lanes);
+    for (; i < n; i++) {
+        if (arr[i] < min) {
+            min = arr[i];
+        }
+    }
+    return min;
+}
+
+__attribute__((target("sse4.1")))
+static int count_sse41(int n, int *arr, int item) {
+    __m128i needle = _mm_set1_epi32(item);
+    __m128i acc = _mm_setzero_si128();
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i eq = _mm_cmpeq_epi32(_mm_loadu_si128((__m128i*) (arr + i)), needle);
+        acc = _mm_sub_epi32(acc, eq);
+    }
+    int lanes[4];
+    _mm_storeu_si128((__m128i*) lanes, acc);
+    return sum_scalar(4, lanes) + count_scalar(n - i, arr + i, item);
+}
+
+__attribute__((target("sse4.1")))
+static int index_of_sse41(int n, int *arr, int item) {
+    __m128i needle = _mm_set1_epi32(item);
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i eq = _mm_cmpeq_epi32(_mm_loadu_si128((__m128i*) (arr + i)), needle);
+        int mask = _mm_movemask_ps(_mm_castsi128_ps(eq));
+        if (mask) {
+            return i + __builtin_ctz(mask);
+        }
+    }
+    int index = index_of_scalar(n - i, arr + i, item);
+    return index == -1 ? -1 : i + index;
+}
+
+__attribute__((target("sse4.1")))
+static int last_index_of_sse41(int n, int *arr, int item) {
+    __m128i needle = _mm_set1_epi32(item);
+    int i = n - n % 4;
+    int index = last_index_of_scalar(n - i, arr + i, item);
+    if (index != -1) {
+        return i + index;
+    }
+    while (i >= 4) {
+        i -= 4;
+        __m128i eq = _mm_cmpeq_epi32(_mm_loadu_si128((__m128i*) (arr + i)), needle);
+        int mask = _mm_movemask_ps(_mm_castsi128_ps(eq));
+        if (mask) {
+            return i + 31 - __builtin_clz(mask);
+        }
+    }
+    return -1;
+}
+
+static const Kernels sse41_kernels = {
+    "sse4.1", sum_sse41, sum64_sse41, max_sse41, min_sse41,
+    count_sse41, index_of_sse41, last_index_of_sse41
+};
+
+/* AVX2 */
+
+__attribute__((target("avx2")))
+static int sum_avx2(int n, int *arr) {
+    __m256i acc = _mm256_setzero_si256();
+    int i = 0;
+    for (; i + 8 <= n; i += 8) {
+        acc = _mm256_add_epi32(acc, _mm256_loadu_si256((__m256i*) (arr + i)));
+    }
+    int lanes[8];
+    _mm256_storeu_si256((__m256i*) lanes, acc);
+    return (int) ((unsigned) sum_scalar(8, lanes) + (unsigned) sum_scalar(n - i, arr + i));
+}
+
+__attribute__((target("avx2")))
+static long long sum64_avx2(int n, int *arr) {
+    __m256i acc = _mm256_setzero_si256();
+    int i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i v = _mm256_loadu_si256((__m256i*) (arr + i));
+        acc = _mm256_add_epi64(acc, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(v)));
+        acc = _mm256_add_epi64(acc, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(v, 1)));
+    }
+    long long lanes[4];
+    _mm256_storeu_si256((__m256i*) lanes, acc);
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3] + sum64_scalar(n - i, arr + i);
+}
+
+__attribute__((target("avx2")))
+static int max_avx2(int n, int *arr) {
+    if (n < 8) {
+        return max_scalar(n, arr);
+    }
+    __m256i acc = _mm256_loadu_si256((__m256i*) arr);
+    int i = 8;
+    for (; i + 8 <= n; i += 8) {
+        acc = _mm256_max_epi32(acc, _mm256_loadu_si256((__m256i*) (arr + i)));
+    }
+    int lanes[8];
+    _mm256_storeu_si256((__m256i*) lanes, acc);
+    int max = max_scalar(8, lanes);
+    for (; i < n; i++) {
+        if (arr[i] > max) {
+            max = arr[i];
+        }
+    }
+    return max;
+}
+
+__attribute__((target("avx2")))
+static int min_avx2(int n, int *arr) {
+    if (n < 8) {
+        return min_scalar(n, arr);
+    }
+    __m256i acc = _mm256_loadu_si256((__m256i*) arr);
+    int i = 8;
+    for (; i + 8 <= n; i += 8) {
+        acc = _mm256_min_epi32(acc, _mm256_loadu_si256((__m256i*) (arr + i)));
+    }
+    int lanes[8];
+    _mm256_storeu_si256((__m256i*) lanes, acc);
+    int min = min_scalar(8, lanes);
+    for (; i < n; i++) {
+        if (arr[i] < min) {
+            min = arr[i];
+        }
+    }
+    return min;
+}
+
+__attribute__((target("avx2")))
+static int count_avx2(int n, int *arr, int item) {
+    __m256i needle = _mm256_set1_epi32(item);
+    __m256i acc = _mm256_setzero_si256();
+    int i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i eq = _mm256_cmpeq_epi32(_mm256_loadu_si256((__m256i*) (arr + i)), needle);
+        acc = _mm256_sub_epi32(acc, eq);
+    }
+    int lanes[8];
+    _mm256_storeu_si256((__m256i*) lanes, acc);
+    return sum_scalar(8, lanes) + count_scalar(n - i, arr + i, item);
+}
+
+__attribute__((target("avx2")))
+static int index_of_avx2(int n, int *arr, int item) {
+    __m256i needle = _mm256_set1_epi32(item);
+    int i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i eq = _mm256_cmpeq_epi32(_mm256_loadu_si256((__m256i*) (arr + i)), needle);
+        int mask = _mm256_movemask_ps(_mm256_castsi256_ps(eq));
+        if (mask) {
+            return i + __builtin_ctz(mask);
+        }
+    }
+    int index = index_of_scalar(n - i, arr + i, item);
+    return index == -1 ? -1 : i + index;
+}
+
+__attribute__((target("avx2")))
+static int last_index_of_avx2(int n, int *arr, int item) {
+    __m256i needle = _mm256_set1_epi32(item);
+    int i = n - n % 8;
+    int index = last_index_of_scalar(n - i, arr + i, item);
+    if (index != -1) {
+        return i + index;
+    }
+    while (i >= 8) {
+        i -= 8;
+        __m256i eq = _mm256_cmpeq_epi32(_mm256_loadu_si256((__m256i*) (arr + i)), needle);
+        int mask = _mm256_movemask_ps(_mm256_castsi256_ps(eq));
+        if (mask) {
+            return i + 31 - __builtin_clz(mask);
+        }
+    }
+    return -1;
+}
+
+static const Kernels avx2_kernels = {
+    "avx2", sum_avx2, sum64_avx2, max_avx2, min_avx2,
+    count_avx2, index_of_avx2, last_index_of_avx2
+};
+
+#endif
+
+/* Selected on first use. Threads that race on it pick the same kernels,
+    so the pointer only needs to be published atomically. */
+static const Kernels *_Atomic kernels = NULL;
+
+static const Kernels* select_kernels() {
+    const Kernels *selected = atomic_load_explicit(&kernels, memory_order_acquire);
+    if (selected) {
+        return selected;
+    }
+#ifdef REDUCE_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        selected = &avx2_kernels;
+    } else if (__builtin_cpu_supports("sse4.1")) {
+        selected = &sse41_kernels;
+    } else {
+        selected = &scalar_kernels;
+    }
+#else
+    selected = &scalar_kernels;
+#endif
+    atomic_store_explicit(&kernels, selected, memory_order_release);
+    return selected;
+}
+
+int sum_array(int n, int *arr) {
+    return select_kernels()->sum(n, arr);
+}
+
+long long sum64_array(int n, int *arr) {
+    return select_kernels()->sum64(n, arr);
+}
+
+int max_array(int n, int *arr) {
+    return select_kernels()->max(n, arr);
+}
+
+int min_array(int n, int *arr) {
+    return select_kernels()->min(n, arr);
+}
+
+int count_array(int n, int *arr, int item) {
+    return select_kernels()->count(n, arr, item);
+}
+
+int contains_array(int n, int *arr, int item) {
+    return select_kernels()->index_of(n, arr, item) != -1;
+}
+
+int index_of_array(int n, int *arr, int item) {
+    return select_kernels()->index_of(n, arr, item);
+}
+
+int last_index_of_array(int n, int *arr, int item) {
+    return select_kernels()->last_index_of(n, arr, item);
+}
+
+const char* reduce_isa() {
+    return select_kernels()->isa;
+}
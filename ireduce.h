@@ -0,0 +1,36 @@
+#ifndef IREDUCE_H_
+#define IREDUCE_H_
+
+/* Vectorized reductions over contiguous integer arrays.
+    AVX2 or SSE4.1 kernels are selected at runtime, with a scalar fallback. */
+
+/* Sums up the elements of the array (wrapping on overflow). */
+extern int sum_array(int, int*);
+
+/* Sums up the elements of the array into a 64-bit accumulator. */
+extern long long sum64_array(int, int*);
+
+/* Finds the largest element of a non-empty array. */
+extern int max_array(int, int*);
+
+/* Finds the smallest element of a non-empty array. */
+extern int min_array(int, int*);
+
+/* Counts the occurrences of the specified element in the array. */
+extern int count_array(int, int*, int);
+
+/* Returns true if the array contains the specified element. */
+extern int contains_array(int, int*, int);
+
+/* Returns the index of the first occurrence of the specified element in the array,
+    or -1 if the array does not contain the element. */
+extern int index_of_array(int, int*, int);
+
+/* Returns the index of the last occurrence of the specified element in the array,
+    or -1 if the array does not contain the element. */
+extern int last_index_of_array(int, int*, int);
+
+/* Returns the name of the instruction set used by the kernels ("avx2", "sse4.1" or "scalar"). */
+extern const char* reduce_isa();
+
+#endif
@@ -0,0 +1,149 @@
+#include <stdlib.h>
+#include <limits.h>
+#include "iset.h"
+
+/* Marks a free slot. The key itself is tracked by has_empty_key. */
+#define EMPTY_KEY INT_MIN
+#define MIN_CAPACITY 16
+
+static int home_slot(ISet *set, int key) {
+    unsigned h = (unsigned) key * 2654435769u;
+    return (int) ((h ^ (h >> 16)) & (unsigned) (set->capacity - 1));
+}
+
+/* Returns the slot holding the key, or the free slot where it belongs. */
+static int find_slot(ISet *set, int key) {
+    int mask = set->capacity - 1;
+    int i = home_slot(set, key);
+    while (set->slots[i] != EMPTY_KEY && set->slots[i] != key) {
+        i = (i + 1) & mask;
+    }
+    return i;
+}
+
+static void alloc_slots(ISet *set, int capacity) {
+    set->capacity = capacity;
+    set->slots = (int*) malloc(capacity * sizeof(int));
+    for (int i = 0; i < capacity; i++) {
+        set->slots[i] = EMPTY_KEY;
+    }
+}
+
+static void rehash(ISet *set, int capacity) {
+    int *old = set->slots;
+    int old_capacity = set->capacity;
+    alloc_slots(set, capacity);
+    for (int i = 0; i < old_capacity; i++) {
+        if (old[i] != EMPTY_KEY) {
+            set->slots[find_slot(set, old[i])] = old[i];
+        }
+    }
+    free(old);
+}
+
+ISet* iset_empty(int expected) {
+    int capacity = MIN_CAPACITY;
+    while (capacity < expected * 2) {
+        capacity *= 2;
+    }
+    ISet *set = (ISet*) malloc(sizeof(ISet));
+    alloc_slots(set, capacity);
+    set->size = 0;
+    set->has_empty_key = 0;
+    return set;
+}
+
+ISet* iset_from_list(IList *list) {
+    ISet *set = iset_empty(list->size);
+    for (Node *cur = list->first; cur; cur = cur->next) {
+        iset_add(set, cur->value);
+    }
+    return set;
+}
+
+void iset_delete(ISet **set) {
+    free((*set)->slots);
+    free(*set);
+    *set = NULL;
+}
+
+int iset_get_size(ISet *set) {
+    return set->size;
+}
+
+int iset_contains(ISet *set, int value) {
+    if (value == EMPTY_KEY) {
+        return set->has_empty_key;
+    }
+    return set->slots[find_slot(set, value)] == value;
+}
+
+int iset_add(ISet *set, int value) {
+    if (value == EMPTY_KEY) {
+        if (set->has_empty_key) {
+            return 0;
+        }
+        set->has_empty_key = 1;
+        set->size++;
+        return 1;
+    }
+    int i = find_slot(set, value);
+    if (set->slots[i] == value) {
+        return 0;
+    }
+    if ((set->size + 1) * 2 > set->capacity) {
+        rehash(set, set->capacity * 2);
+        i = find_slot(set, value);
+    }
+    set->slots[i] = value;
+    set->size++;
+    return 1;
+}
+
+int iset_remove(ISet *set, int value) {
+    if (value == EMPTY_KEY) {
+        if (!set->has_empty_key) {
+            return 0;
+        }
+        set->has_empty_key = 0;
+        set->size--;
+        return 1;
+    }
+    int i = find_slot(set, value);
+    if (set->slots[i] != value) {
+        return 0;
+    }
+    /* Backward shift deletion keeps probe sequences intact without tombstones. */
+    int mask = set->capacity - 1;
+    for (int j = (i + 1) & mask; set->slots[j] != EMPTY_KEY; j = (j + 1) & mask) {
+        int home = home_slot(set, set->slots[j]);
+        if (((j - home) & mask) >= ((j - i) & mask)) {
+            set->slots[i] = set->slots[j];
+            i = j;
+        }
+    }
+    set->slots[i] = EMPTY_KEY;
+    set->size--;
+    return 1;
+}
+
+void iset_clear(ISet *set) {
+    for (int i = 0; i < set->capacity; i++) {
+        set->slots[i] = EMPTY_KEY;
+    }
+    set->size = 0;
+    set->has_empty_key = 0;
+}
+
+IList* iset_to_list(ISet *set) {
+    IList *list = empty_list();
+    if (set->has_empty_key) {
+        push_back(list, EMPTY_KEY);
+    }
+    for (int i = 0; i < set->capacity; i++) {
+        if (set->slots[i] != EMPTY_KEY) {
+            push_back(list, set->slots[i]);
+        }
+    }
+    return list;
+}
@@ -0,0 +1,44 @@
+#ifndef ISET_H_
+#define ISET_H_
+
+#include "ilist.h"
+
+/* Integer Hash Set (open addressing with linear probing) */
+
+typedef struct {
+    int *slots;
+    int capacity;
+    int size;
+    int has_empty_key;
+} ISet;
+
+/* Returns an empty set with room for the specified number of elements. */
+extern ISet* iset_empty(int);
+
+/* Returns a set containing the elements of the list. */
+extern ISet* iset_from_list(IList*);
+
+/* Delete the set. */
+extern void iset_delete(ISet**);
+
+/* Returns a size of the set. */
+extern int iset_get_size(ISet*);
+
+/* Returns true if the set contains the specified element. */
+extern int iset_contains(ISet*, int);
+
+/* [Mutator] Adds the specified element to the set.
+    Returns true if the set did not already contain the element. */
+extern int iset_add(ISet*, int);
+
+/* [Mutator] Removes the specified element from the set.
+    Returns true if the set contained the element. */
+extern int iset_remove(ISet*, int);
+
+/* [Mutator] Removes all of the elements from the set. */
+extern void iset_clear(ISet*);
+
+/* Returns a list containing the elements of the set in unspecified order. */
+extern IList* iset_to_list(ISet*);
+
+#endif
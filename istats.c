@@ -0,0 +1,192 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <time.h>
+#include "istats.h"
+
+#ifdef ILIST_INSTRUMENT
+
+static atomic_llong allocs;
+static atomic_llong frees;
+static atomic_llong live;
+static atomic_llong peak_live;
+static atomic_llong steps;
+static atomic_int timing = 1;
+
+/* Functions called at least once, most recently registered first. */
+static _Atomic(StatsSite*) sites;
+
+static StatsHooks hooks;
+
+static long long now_ns() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+int stats_enabled() {
+    return 1;
+}
+
+void stats_alloc(IList *list, int n) {
+    list->counters.allocs += n;
+    atomic_fetch_add_explicit(&allocs, n, memory_order_relaxed);
+    long long now = atomic_fetch_add_explicit(&live, n, memory_order_relaxed) + n;
+    long long peak = atomic_load_explicit(&peak_live, memory_order_relaxed);
+    while (now > peak && !atomic_compare_exchange_weak_explicit(&peak_live, &peak, now,
+            memory_order_relaxed, memory_order_relaxed));
+    if (hooks.on_alloc) {
+        hooks.on_alloc(n, now, hooks.ctx);
+    }
+}
+
+void stats_free(IList *list, int n) {
+    if (n <= 0) {
+        return;
+    }
+    list->counters.frees += n;
+    atomic_fetch_add_explicit(&frees, n, memory_order_relaxed);
+    long long now = atomic_fetch_sub_explicit(&live, n, memory_order_relaxed) - n;
+    if (hooks.on_free) {
+        hooks.on_free(n, now, hooks.ctx);
+    }
+}
+
+void stats_steps(IList *list, int n) {
+    list->counters.steps += n;
+    atomic_fetch_add_explicit(&steps, n, memory_order_relaxed);
+}
+
+long long stats_enter(StatsSite *site) {
+    if (!atomic_load_explicit(&site->registered, memory_order_acquire)) {
+        int expected = 0;
+        if (atomic_compare_exchange_strong(&site->registered, &expected, 1)) {
+            site->next = atomic_load(&sites);
+            while (!atomic_compare_exchange_weak(&sites, &site->next, site));
+        }
+    }
+    return atomic_load_explicit(&timing, memory_order_relaxed) ? now_ns() : 0;
+}
+
+void stats_exit(StatsSite *site, long long start) {
+    long long ns = start ? now_ns() - start : 0;
+    atomic_fetch_add_explicit(&site->calls, 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&site->ns, ns, memory_order_relaxed);
+    if (hooks.on_call) {
+        hooks.on_call(site->name, ns, hooks.ctx);
+    }
+}
+
+void stats_snapshot(IStats *stats) {
+    stats->allocs = atomic_load(&allocs);
+    stats->frees = atomic_load(&frees);
+    stats->live = atomic_load(&live);
+    stats->peak_live = atomic_load(&peak_live);
+    stats->steps = atomic_load(&steps);
+}
+
+IListCounters stats_of_list(IList *list) {
+    return list->counters;
+}
+
+void stats_foreach_function(void (*op)(const IFunctionStats*, void*), void *ctx) {
+    for (StatsSite *site = atomic_load(&sites); site; site = site->next) {
+        IFunctionStats fn = { site->name, atomic_load(&site->calls), atomic_load(&site->ns) };
+        if (fn.calls) {
+            op(&fn, ctx);
+        }
+    }
+}
+
+void stats_reset() {
+    atomic_store(&allocs, 0);
+    atomic_store(&frees, 0);
+    atomic_store(&peak_live, atomic_load(&live));
+    atomic_store(&steps, 0);
+    for (StatsSite *site = atomic_load(&sites); site; site = site->next) {
+        atomic_store(&site->calls, 0);
+        atomic_store(&site->ns, 0);
+    }
+}
+
+void stats_set_hooks(const StatsHooks *new_hooks) {
+    if (new_hooks) {
+        hooks = *new_hooks;
+    } else {
+        hooks = (StatsHooks) { NULL, NULL, NULL, NULL };
+    }
+}
+
+void stats_set_timing(int on) {
+    atomic_store(&timing, on);
+}
+
+#else
+
+int stats_enabled() {
+    return 0;
+}
+
+void stats_alloc(IList *list, int n) {
+    (void) list;
+    (void) n;
+}
+
+void stats_free(IList *list, int n) {
+    (void) list;
+    (void) n;
+}
+
+void stats_steps(IList *list, int n) {
+    (void) list;
+    (void) n;
+}
+
+long long stats_enter(StatsSite *site) {
+    (void) site;
+    return 0;
+}
+
+void stats_exit(StatsSite *site, long long start) {
+    (void) site;
+    (void) start;
+}
+
+void stats_snapshot(IStats *stats) {
+    *stats = (IStats) { 0, 0, 0, 0, 0 };
+}
+
+IListCounters stats_of_list(IList *list) {
+    (void) list;
+    return (IListCounters) { 0, 0, 0 };
+}
+
+void stats_foreach_function(void (*op)(const IFunctionStats*, void*), void *ctx) {
+    (void) op;
+    (void) ctx;
+}
+
+void stats_reset() {
+}
+
+void stats_set_hooks(const StatsHooks *new_hooks) {
+    (void) new_hooks;
+}
+
+void stats_set_timing(int on) {
+    (void) on;
+}
+
+#endif
+
+static void dump_function(const IFunctionStats *fn, void *ctx) {
+    fprintf((FILE*) ctx, "  %-20s %12lld calls %14lld ns %10.1f ns/call\n",
+            fn->name, fn->calls, fn->ns, (double) fn->ns / fn->calls);
+}
+
+void stats_dump(FILE *out) {
+    IStats stats;
+    stats_snapshot(&stats);
+    fprintf(out, "ilist: %lld allocs, %lld frees, %lld live, %lld peak live nodes, %lld lookup steps\n",
+            stats.allocs, stats.frees, stats.live, stats.peak_live, stats.steps);
+    stats_foreach_function(dump_function, out);
+}
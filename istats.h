@@ -0,0 +1,111 @@
+#ifndef ISTATS_H_
+#define ISTATS_H_
+
+#include <stdio.h>
+#include "ilist.h"
+
+/* Instrumentation
+
+    Building with ILIST_INSTRUMENT defined (make INSTRUMENT=1) counts node
+    allocations and frees, live and peak live nodes, the nodes walked by
+    positional lookups (get_node and everything built on it), and the calls
+    and cumulative time of the main IList operations. Each list also keeps
+    its own counters. Without the flag the hooks compile to nothing and the
+    functions below report zeros.
+
+    The flag adds a field to IList, so the library and the code that uses
+    it must be built with the same setting. Global counters are atomic;
+    the counters of a list are as thread-safe as the list itself. */
+
+typedef struct {
+    long long allocs;
+    long long frees;
+    long long live;
+    long long peak_live;
+    long long steps;
+} IStats;
+
+/* Calls and cumulative time (inclusive of nested calls) of one function. */
+typedef struct {
+    const char *name;
+    long long calls;
+    long long ns;
+} IFunctionStats;
+
+/* Callbacks for exporting the events as they happen. Any of them may be NULL.
+    They are called on the thread that performs the operation. */
+typedef struct {
+    void (*on_alloc)(int nodes, long long live, void *ctx);
+    void (*on_free)(int nodes, long long live, void *ctx);
+    void (*on_call)(const char *name, long long ns, void *ctx);
+    void *ctx;
+} StatsHooks;
+
+/* Returns true if the library was built with ILIST_INSTRUMENT. */
+extern int stats_enabled();
+
+/* Stores the global counters into the struct. */
+extern void stats_snapshot(IStats*);
+
+/* Returns the counters of the list. */
+extern IListCounters stats_of_list(IList*);
+
+/* Calls the function for each instrumented function that was called at least once. */
+extern void stats_foreach_function(void (*op)(const IFunctionStats*, void*), void*);
+
+/* Writes the global counters and the per-function table to the stream. */
+extern void stats_dump(FILE*);
+
+/* Resets the global and per-function counters, except the live node count. */
+extern void stats_reset();
+
+/* Installs the callbacks (copied), or removes them if NULL.
+    Install them before other threads use the library. */
+extern void stats_set_hooks(const StatsHooks*);
+
+/* Turns timing of function calls on or off; calls are still counted. On by default. */
+extern void stats_set_timing(int);
+
+/* Hooks used by the library */
+
+typedef struct StatsSite StatsSite;
+
+extern void stats_alloc(IList*, int);
+extern void stats_free(IList*, int);
+extern void stats_steps(IList*, int);
+extern long long stats_enter(StatsSite*);
+extern void stats_exit(StatsSite*, long long);
+
+#ifdef ILIST_INSTRUMENT
+
+#include <stdatomic.h>
+
+struct StatsSite {
+    const char *name;
+    atomic_llong calls;
+    atomic_llong ns;
+    atomic_int registered;
+    StatsSite *next;
+};
+
+#define STATS_ALLOC(list, n) stats_alloc(list, n)
+#define STATS_FREE(list, n) stats_free(list, n)
+#define STATS_STEPS(list, n) stats_steps(list, n)
+
+/* Opens a timed call of the enclosing function; every return must be preceded by STATS_EXIT. */
+#define STATS_ENTER() \
+    static StatsSite stats_site_ = { __func__ }; \
+    long long stats_start_ = stats_enter(&stats_site_)
+#define STATS_EXIT() stats_exit(&stats_site_, stats_start_)
+
+#else
+
+#define STATS_ALLOC(list, n) ((void) 0)
+#define STATS_FREE(list, n) ((void) 0)
+#define STATS_STEPS(list, n) ((void) 0)
+#define STATS_ENTER() ((void) 0)
+#define STATS_EXIT() ((void) 0)
+
+#endif
+
+#endif
@@ -0,0 +1,435 @@
+#include <stdlib.h>
+#include "istream.h"
+
+typedef enum {
+    SOURCE_LIST,
+    SOURCE_RANGE,
+    SOURCE_RANGE_EX,
+    SOURCE_GENERATE_N,
+    SOURCE_GENERATE_WHILE
+} SourceKind;
+
+typedef enum {
+    STAGE_MAP,
+    STAGE_FILTER,
+    STAGE_FILTER_NOT,
+    STAGE_TAKE,
+    STAGE_TAKE_WHILE,
+    STAGE_DROP,
+    STAGE_DROP_WHILE,
+    STAGE_INTERSPERSE
+} StageKind;
+
+typedef struct {
+    StageKind kind;
+    i_func op;
+    i_func_ctx op_ctx;
+    void *ctx;
+    int n;
+    int seen;
+} Stage;
+
+/* Receives the elements that pass every stage; returns false to stop the stream. */
+typedef int (*Sink)(void*, int);
+
+struct IStream {
+    SourceKind source;
+    IList *list;
+    int first;
+    int last;
+    int step;
+    int count;
+    i_func op;
+    i_func cond;
+    i_func_ctx op_ctx;
+    i_func_ctx cond_ctx;
+    void *ctx;
+    Stage *stages;
+    int depth;
+    int capacity;
+};
+
+static IStream* new_stream(SourceKind source) {
+    IStream *stream = (IStream*) calloc(1, sizeof(IStream));
+    stream->source = source;
+    return stream;
+}
+
+static IStream* add_stage_ctx(IStream *stream, StageKind kind, i_func op, i_func_ctx op_ctx, void *ctx, int n) {
+    if (stream->depth == stream->capacity) {
+        stream->capacity = stream->capacity ? stream->capacity * 2 : 4;
+        stream->stages = (Stage*) realloc(stream->stages, stream->capacity * sizeof(Stage));
+    }
+    Stage *stage = &stream->stages[stream->depth++];
+    stage->kind = kind;
+    stage->op = op;
+    stage->op_ctx = op_ctx;
+    stage->ctx = ctx;
+    stage->n = n;
+    stage->seen = 0;
+    return stream;
+}
+
+static IStream* add_stage(IStream *stream, StageKind kind, i_func op, int n) {
+    return add_stage_ctx(stream, kind, op, NULL, NULL, n);
+}
+
+/* Calls the stage's function, passing the context if it takes one. */
+static inline int apply(const Stage *stage, int value) {
+    return stage->op ? stage->op(value) : stage->op_ctx(value, stage->ctx);
+}
+
+/* The step and the condition of a generated source. */
+static inline int next_value(const IStream *stream, int value) {
+    return stream->op ? stream->op(value) : stream->op_ctx(value, stream->ctx);
+}
+
+static inline int holds(const IStream *stream, int value) {
+    return stream->cond ? stream->cond(value) : stream->cond_ctx(value, stream->ctx);
+}
+
+/* Passes the value through the stages starting at the index and into the sink.
+    Returns false once no more elements are wanted. */
+static int emit(IStream *stream, int index, int value, Sink sink, void *ctx) {
+    for (; index < stream->depth; index++) {
+        Stage *stage = &stream->stages[index];
+        switch (stage->kind) {
+        case STAGE_MAP:
+            value = apply(stage, value);
+            break;
+        case STAGE_FILTER:
+            if (!apply(stage, value)) {
+                return 1;
+            }
+            break;
+        case STAGE_FILTER_NOT:
+            if (apply(stage, value)) {
+                return 1;
+            }
+            break;
+        case STAGE_TAKE:
+            if (stage->seen >= stage->n) {
+                return 0;
+            }
+            if (++stage->seen == stage->n) {
+                emit(stream, index + 1, value, sink, ctx);
+                return 0;
+            }
+            break;
+        case STAGE_TAKE_WHILE:
+            if (!apply(stage, value)) {
+                return 0;
+            }
+            break;
+        case STAGE_DROP:
+            if (stage->seen < stage->n) {
+                stage->seen++;
+                return 1;
+            }
+            break;
+        case STAGE_DROP_WHILE:
+            if (!stage->seen) {
+                if (apply(stage, value)) {
+                    return 1;
+                }
+                stage->seen = 1;
+            }
+            break;
+        case STAGE_INTERSPERSE:
+            if (stage->seen && !emit(stream, index + 1, stage->n, sink, ctx)) {
+                return 0;
+            }
+            stage->seen = 1;
+            break;
+        }
+    }
+    return sink(ctx, value);
+}
+
+/* Runs the stream into the sink and deletes it. */
+static void run(IStream *stream, Sink sink, void *ctx) {
+    switch (stream->source) {
+    case SOURCE_LIST:
+        for (Node *cur = stream->list->first; cur; cur = cur->next) {
+            if (!emit(stream, 0, cur->value, sink, ctx)) {
+                break;
+            }
+        }
+        break;
+    case SOURCE_RANGE:
+    case SOURCE_RANGE_EX: {
+        long long last = stream->last;
+        if (stream->source == SOURCE_RANGE_EX) {
+            last += stream->step > 0 ? -1 : 1;
+        }
+        if (stream->step > 0) {
+            for (long long i = stream->first; i <= last; i += stream->step) {
+                if (!emit(stream, 0, (int) i, sink, ctx)) {
+                    break;
+                }
+            }
+        } else if (stream->step < 0) {
+            for (long long i = stream->first; i >= last; i += stream->step) {
+                if (!emit(stream, 0, (int) i, sink, ctx)) {
+                    break;
+                }
+            }
+        }
+        break;
+    }
+    case SOURCE_GENERATE_N:
+        for (int cur = stream->first, i = 0; i < stream->count; i++) {
+            if (!emit(stream, 0, cur, sink, ctx)) {
+                break;
+            }
+            if (i + 1 < stream->count) {
+                cur = next_value(stream, cur);
+            }
+        }
+        break;
+    case SOURCE_GENERATE_WHILE:
+        for (int cur = stream->first; holds(stream, cur); cur = next_value(stream, cur)) {
+            if (!emit(stream, 0, cur, sink, ctx)) {
+                break;
+            }
+        }
+        break;
+    }
+    stream_delete(&stream);
+}
+
+IStream* stream_of(IList *list) {
+    IStream *stream = new_stream(SOURCE_LIST);
+    stream->list = list;
+    return stream;
+}
+
+IStream* stream_range_step(int first, int last, int step) {
+    IStream *stream = new_stream(SOURCE_RANGE);
+    stream->first = first;
+    stream->last = last;
+    stream->step = step;
+    return stream;
+}
+
+IStream* stream_range_step_ex(int first, int last, int step) {
+    IStream *stream = stream_range_step(first, last, step);
+    stream->source = SOURCE_RANGE_EX;
+    return stream;
+}
+
+IStream* stream_generate_n(int start, i_func op, int count) {
+    IStream *stream = new_stream(SOURCE_GENERATE_N);
+    stream->first = start;
+    stream->op = op;
+    stream->count = count;
+    return stream;
+}
+
+IStream* stream_generate_while(int start, i_func op, i_func cond) {
+    IStream *stream = new_stream(SOURCE_GENERATE_WHILE);
+    stream->first = start;
+    stream->op = op;
+    stream->cond = cond;
+    return stream;
+}
+
+IStream* stream_generate_n_ctx(int start, i_func_ctx op, int count, void *ctx) {
+    IStream *stream = new_stream(SOURCE_GENERATE_N);
+    stream->first = start;
+    stream->op_ctx = op;
+    stream->ctx = ctx;
+    stream->count = count;
+    return stream;
+}
+
+IStream* stream_generate_while_ctx(int start, i_func_ctx op, i_func_ctx cond, void *ctx) {
+    IStream *stream = new_stream(SOURCE_GENERATE_WHILE);
+    stream->first = start;
+    stream->op_ctx = op;
+    stream->cond_ctx = cond;
+    stream->ctx = ctx;
+    return stream;
+}
+
+void stream_delete(IStream **stream) {
+    free((*stream)->stages);
+    free(*stream);
+    *stream = NULL;
+}
+
+IStream* stream_map(IStream *stream, i_func op) {
+    return add_stage(stream, STAGE_MAP, op, 0);
+}
+
+IStream* stream_filter(IStream *stream, i_func pred) {
+    return add_stage(stream, STAGE_FILTER, pred, 0);
+}
+
+IStream* stream_filter_not(IStream *stream, i_func pred) {
+    return add_stage(stream, STAGE_FILTER_NOT, pred, 0);
+}
+
+IStream* stream_take(IStream *stream, int n) {
+    return add_stage(stream, STAGE_TAKE, NULL, n);
+}
+
+IStream* stream_take_while(IStream *stream, i_func pred) {
+    return add_stage(stream, STAGE_TAKE_WHILE, pred, 0);
+}
+
+IStream* stream_drop(IStream *stream, int n) {
+    return add_stage(stream, STAGE_DROP, NULL, n);
+}
+
+IStream* stream_drop_while(IStream *stream, i_func pred) {
+    return add_stage(stream, STAGE_DROP_WHILE, pred, 0);
+}
+
+IStream* stream_intersperse(IStream *stream, int value) {
+    return add_stage(stream, STAGE_INTERSPERSE, NULL, value);
+}
+
+IStream* stream_map_ctx(IStream *stream, i_func_ctx op, void *ctx) {
+    return add_stage_ctx(stream, STAGE_MAP, NULL, op, ctx, 0);
+}
+
+IStream* stream_filter_ctx(IStream *stream, i_func_ctx pred, void *ctx) {
+    return add_stage_ctx(stream, STAGE_FILTER, NULL, pred, ctx, 0);
+}
+
+IStream* stream_filter_not_ctx(IStream *stream, i_func_ctx pred, void *ctx) {
+    return add_stage_ctx(stream, STAGE_FILTER_NOT, NULL, pred, ctx, 0);
+}
+
+IStream* stream_take_while_ctx(IStream *stream, i_func_ctx pred, void *ctx) {
+    return add_stage_ctx(stream, STAGE_TAKE_WHILE, NULL, pred, ctx, 0);
+}
+
+IStream* stream_drop_while_ctx(IStream *stream, i_func_ctx pred, void *ctx) {
+    return add_stage_ctx(stream, STAGE_DROP_WHILE, NULL, pred, ctx, 0);
+}
+
+typedef struct {
+    int acc;
+    i_bifunc op;
+    i_bifunc_ctx op_ctx;
+    void *ctx;
+} FoldState;
+
+static int fold_sink(void *ctx, int value) {
+    FoldState *state = (FoldState*) ctx;
+    state->acc = state->op(state->acc, value);
+    return 1;
+}
+
+static int fold_ctx_sink(void *ctx, int value) {
+    FoldState *state = (FoldState*) ctx;
+    state->acc = state->op_ctx(state->acc, value, state->ctx);
+    return 1;
+}
+
+int stream_fold_left(int init, IStream *stream, i_bifunc op) {
+    FoldState state = { init, op, NULL, NULL };
+    run(stream, fold_sink, &state);
+    return state.acc;
+}
+
+int stream_fold_left_ctx(int init, IStream *stream, i_bifunc_ctx op, void *ctx) {
+    FoldState state = { init, NULL, op, ctx };
+    run(stream, fold_ctx_sink, &state);
+    return state.acc;
+}
+
+static int count_sink(void *ctx, int value) {
+    (void) value;
+    (*(int*) ctx)++;
+    return 1;
+}
+
+int stream_count(IStream *stream) {
+    int count = 0;
+    run(stream, count_sink, &count);
+    return count;
+}
+
+static int sum_sink(void *ctx, int value) {
+    *(unsigned*) ctx += (unsigned) value;
+    return 1;
+}
+
+int stream_sum(IStream *stream) {
+    unsigned sum = 0;
+    run(stream, sum_sink, &sum);
+    return (int) sum;
+}
+
+static int sum64_sink(void *ctx, int value) {
+    *(long long*) ctx += value;
+    return 1;
+}
+
+long long stream_sum64(IStream *stream) {
+    long long sum = 0;
+    run(stream, sum64_sink, &sum);
+    return sum;
+}
+
+static int foreach_sink(void *ctx, int value) {
+    (*(void (**)(int)) ctx)(value);
+    return 1;
+}
+
+void stream_foreach(IStream *stream, void (*op)(int)) {
+    run(stream, foreach_sink, &op);
+}
+
+typedef struct {
+    void (*op)(int, void*);
+    void *ctx;
+} ForeachState;
+
+static int foreach_ctx_sink(void *ctx, int value) {
+    ForeachState *state = (ForeachState*) ctx;
+    state->op(value, state->ctx);
+    return 1;
+}
+
+void stream_foreach_ctx(IStream *stream, void (*op)(int, void*), void *ctx) {
+    ForeachState state = { op, ctx };
+    run(stream, foreach_ctx_sink, &state);
+}
+
+static int collect_sink(void *ctx, int value) {
+    push_back((IList*) ctx, value);
+    return 1;
+}
+
+IList* stream_collect(IStream *stream) {
+    IList *result = empty_list();
+    run(stream, collect_sink, result);
+    return result;
+}
+
+typedef struct {
+    int *arr;
+    int size;
+    int capacity;
+} ArrayState;
+
+static int array_sink(void *ctx, int value) {
+    ArrayState *state = (ArrayState*) ctx;
+    if (state->size == state->capacity) {
+        state->capacity = state->capacity ? state->capacity * 2 : 16;
+        state->arr = (int*) realloc(state->arr, state->capacity * sizeof(int));
+    }
+    state->arr[state->size++] = value;
+    return 1;
+}
+
+int* stream_to_array(IStream *stream, int *size) {
+    ArrayState state = { NULL, 0, 0 };
+    run(stream, array_sink, &state);
+    *size = state.size;
+    return state.arr;
+}
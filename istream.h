@@ -0,0 +1,111 @@
+#ifndef ISTREAM_H_
+#define ISTREAM_H_
+
+#include "ilist.h"
+
+/* Lazy Integer Stream
+
+    A stream is a source followed by a chain of stages. Stages only record
+    what to do; a terminal operation runs the whole chain in a single pass
+    without building intermediate lists, and deletes the stream.
+
+    The _ctx variants take callbacks that receive a context pointer,
+    which is stored with the stage and passed to every call. */
+
+typedef struct IStream IStream;
+
+/* Returns a stream over the elements of the list. The list must outlive the stream. */
+extern IStream* stream_of(IList*);
+
+/* Returns a stream from start (inclusive) to end (inclusive) by a specified step. */
+extern IStream* stream_range_step(int, int, int);
+
+/* Returns a stream from start (inclusive) to end (exclusive) by a specified step. */
+extern IStream* stream_range_step_ex(int, int, int);
+
+/* Returns a stream of n elements produced by iterative application
+    of a function to an initial element. */
+extern IStream* stream_generate_n(int, i_func, int);
+
+/* Returns a stream produced by iterative application of a function
+    to an initial element while the condition is satisfied. */
+extern IStream* stream_generate_while(int, i_func, i_func);
+
+/* stream_generate_n with a function that receives the context. */
+extern IStream* stream_generate_n_ctx(int, i_func_ctx, int, void*);
+
+/* stream_generate_while with a function and a condition that receive the context. */
+extern IStream* stream_generate_while_ctx(int, i_func_ctx, i_func_ctx, void*);
+
+/* Delete the stream without running it. */
+extern void stream_delete(IStream**);
+
+/* [Stage] Applies the given function to the elements of the stream. */
+extern IStream* stream_map(IStream*, i_func);
+
+/* [Stage] Keeps the elements of the stream that match the given predicate. */
+extern IStream* stream_filter(IStream*, i_func);
+
+/* [Stage] Keeps the elements of the stream that match the negation of the given predicate. */
+extern IStream* stream_filter_not(IStream*, i_func);
+
+/* [Stage] Keeps first n elements of the stream. */
+extern IStream* stream_take(IStream*, int);
+
+/* [Stage] Keeps the longest prefix of elements that satisfy a predicate. */
+extern IStream* stream_take_while(IStream*, i_func);
+
+/* [Stage] Skips first n elements of the stream. */
+extern IStream* stream_drop(IStream*, int);
+
+/* [Stage] Skips first elements of the stream while the condition is satisfied. */
+extern IStream* stream_drop_while(IStream*, i_func);
+
+/* [Stage] Puts the element between the elements of the stream. */
+extern IStream* stream_intersperse(IStream*, int);
+
+/* [Stage] stream_map with a function that receives the context. */
+extern IStream* stream_map_ctx(IStream*, i_func_ctx, void*);
+
+/* [Stage] stream_filter with a predicate that receives the context. */
+extern IStream* stream_filter_ctx(IStream*, i_func_ctx, void*);
+
+/* [Stage] stream_filter_not with a predicate that receives the context. */
+extern IStream* stream_filter_not_ctx(IStream*, i_func_ctx, void*);
+
+/* [Stage] stream_take_while with a predicate that receives the context. */
+extern IStream* stream_take_while_ctx(IStream*, i_func_ctx, void*);
+
+/* [Stage] stream_drop_while with a predicate that receives the context. */
+extern IStream* stream_drop_while_ctx(IStream*, i_func_ctx, void*);
+
+/* [Terminal] Applies a binary operator to a start value and all elements of the stream,
+    going left to right. */
+extern int stream_fold_left(int, IStream*, i_bifunc);
+
+/* [Terminal] stream_fold_left with an operator that receives the context. */
+extern int stream_fold_left_ctx(int, IStream*, i_bifunc_ctx, void*);
+
+/* [Terminal] Counts the elements of the stream. */
+extern int stream_count(IStream*);
+
+/* [Terminal] Sums up the elements of the stream. */
+extern int stream_sum(IStream*);
+
+/* [Terminal] Sums up the elements of the stream into a 64-bit accumulator. */
+extern long long stream_sum64(IStream*);
+
+/* [Terminal] Performs the given action for each element of the stream. */
+extern void stream_foreach(IStream*, void (*op)(int));
+
+/* [Terminal] stream_foreach with an action that receives the context. */
+extern void stream_foreach_ctx(IStream*, void (*op)(int, void*), void*);
+
+/* [Terminal] Returns a list containing the elements of the stream. */
+extern IList* stream_collect(IStream*);
+
+/* [Terminal] Returns an array containing the elements of the stream
+    and stores its length into the second argument. */
+extern int* stream_to_array(IStream*, int*);
+
+#endif
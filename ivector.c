@@ -0,0 +1,738 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include <string.h>
+#include "ivector.h"
+#include "ireduce.h"
+#include "iset.h"
+#include "icallback.h"
+
+#define MIN_CAPACITY 8
+
+static void grow(IVector *vector, int capacity) {
+    if (capacity <= vector->capacity) {
+        return;
+    }
+    int new_capacity = vector->capacity > 0 ? vector->capacity : MIN_CAPACITY;
+    while (new_capacity < capacity) {
+        new_capacity *= 2;
+    }
+    vector->data = (int*) realloc(vector->data, new_capacity * sizeof(int));
+    vector->capacity = new_capacity;
+}
+
+/* Returns a new vector with a copy of n elements starting at the array. */
+static IVector* copy_of(int n, int *arr) {
+    IVector *result = ivector_empty_list();
+    if (n > 0) {
+        grow(result, n);
+        memcpy(result->data, arr, n * sizeof(int));
+        result->size = n;
+    }
+    return result;
+}
+
+int ivector_is_empty(IVector *vector) {
+    return vector->size == 0;
+}
+
+int ivector_is_not_empty(IVector *vector) {
+    return vector->size != 0;
+}
+
+IVector* ivector_empty_list() {
+    IVector *vector = (IVector*) malloc(sizeof(IVector));
+    vector->data = NULL;
+    vector->size = 0;
+    vector->capacity = 0;
+    return vector;
+}
+
+IVector* ivector_with_capacity(int capacity) {
+    IVector *vector = ivector_empty_list();
+    grow(vector, capacity);
+    return vector;
+}
+
+IVector* ivector_single_list_of(int value) {
+    return ivector_push_back(ivector_empty_list(), value);
+}
+
+IVector* ivector_list_of(int count, ...) {
+    va_list items;
+    va_start(items, count);
+    IVector *vector = ivector_with_capacity(count);
+    for (int i = 0; i < count; i++) {
+        vector->data[i] = va_arg(items, int);
+    }
+    vector->size = count;
+    va_end(items);
+    return vector;
+}
+
+IVector* ivector_range(int first, int last) {
+    return ivector_range_step(first, last, first < last ? 1 : -1);
+}
+
+IVector* ivector_range_step(int first, int last, int step) {
+    IVector *vector = ivector_empty_list();
+    if (step > 0) {
+        for (int i = first; i <= last; i += step) {
+            ivector_push_back(vector, i);
+        }
+    } else {
+        for (int i = first; i >= last; i += step) {
+            ivector_push_back(vector, i);
+        }
+    }
+    return vector;
+}
+
+IVector* ivector_range_ex(int first, int last) {
+    return ivector_range_step_ex(first, last, first < last ? 1 : -1);
+}
+
+IVector* ivector_range_step_ex(int first, int last, int step) {
+    IVector *vector = ivector_empty_list();
+    if (step > 0) {
+        for (int i = first; i < last; i += step) {
+            ivector_push_back(vector, i);
+        }
+    } else {
+        for (int i = first; i > last; i += step) {
+            ivector_push_back(vector, i);
+        }
+    }
+    return vector;
+}
+
+static IVector* generate_count(int start, const Callback *op, int count) {
+    IVector *vector = ivector_with_capacity(count);
+    for (int cur = start, i = 0; i < count; cur = apply(op, cur), i++) {
+        vector->data[i] = cur;
+    }
+    vector->size = count > 0 ? count : 0;
+    return vector;
+}
+
+IVector* ivector_generate_n(int start, i_func op, int count) {
+    return generate_count(start, PLAIN(op), count);
+}
+
+IVector* ivector_generate_n_ctx(int start, i_func_ctx op, int count, void *ctx) {
+    return generate_count(start, WITH_CTX(op, ctx), count);
+}
+
+static IVector* generate_until(int start, const Callback *op, const Callback *cond) {
+    IVector *vector = ivector_empty_list();
+    for (int cur = start; apply(cond, cur); cur = apply(op, cur)) {
+        ivector_push_back(vector, cur);
+    }
+    return vector;
+}
+
+IVector* ivector_generate_while(int start, i_func op, i_func cond) {
+    return generate_until(start, PLAIN(op), PLAIN(cond));
+}
+
+IVector* ivector_generate_while_ctx(int start, i_func_ctx op, i_func_ctx cond, void *ctx) {
+    return generate_until(start, WITH_CTX(op, ctx), WITH_CTX(cond, ctx));
+}
+
+IVector* ivector_repeat(int value, int count) {
+    IVector *vector = ivector_with_capacity(count);
+    for (int i = 0; i < count; i++) {
+        vector->data[i] = value;
+    }
+    vector->size = count > 0 ? count : 0;
+    return vector;
+}
+
+void ivector_delete_list(IVector **vector) {
+    free((*vector)->data);
+    free(*vector);
+    *vector = NULL;
+}
+
+int ivector_equals(IVector *fst, IVector *snd) {
+    return fst->size == snd->size
+        && (fst->size == 0 || memcmp(fst->data, snd->data, fst->size * sizeof(int)) == 0);
+}
+
+int ivector_get_size(IVector *vector) {
+    return vector->size;
+}
+
+int ivector_get_capacity(IVector *vector) {
+    return vector->capacity;
+}
+
+IVector* ivector_reserve(IVector *vector, int capacity) {
+    grow(vector, capacity);
+    return vector;
+}
+
+IVector* ivector_shrink_to_fit(IVector *vector) {
+    if (vector->size == 0) {
+        free(vector->data);
+        vector->data = NULL;
+    } else {
+        vector->data = (int*) realloc(vector->data, vector->size * sizeof(int));
+    }
+    vector->capacity = vector->size;
+    return vector;
+}
+
+IVector* ivector_push(IVector *vector, int value) {
+    return ivector_insert(vector, 0, value);
+}
+
+IVector* ivector_push_back(IVector *vector, int value) {
+    if (vector->size == vector->capacity) {
+        grow(vector, vector->size + 1);
+    }
+    vector->data[vector->size++] = value;
+    return vector;
+}
+
+IVector* ivector_insert(IVector *vector, int pos, int value) {
+    grow(vector, vector->size + 1);
+    memmove(vector->data + pos + 1, vector->data + pos, (vector->size - pos) * sizeof(int));
+    vector->data[pos] = value;
+    vector->size++;
+    return vector;
+}
+
+int ivector_pop(IVector *vector) {
+    int value = vector->data[0];
+    ivector_drop(vector);
+    return value;
+}
+
+int ivector_pop_back(IVector *vector) {
+    return vector->data[--vector->size];
+}
+
+IVector* ivector_delete(IVector *vector, int pos) {
+    memmove(vector->data + pos, vector->data + pos + 1, (vector->size - pos - 1) * sizeof(int));
+    vector->size--;
+    return vector;
+}
+
+IVector* ivector_delete_item(IVector *vector, int value) {
+    int size = 0;
+    for (int i = 0; i < vector->size; i++) {
+        if (vector->data[i] != value) {
+            vector->data[size++] = vector->data[i];
+        }
+    }
+    vector->size = size;
+    return vector;
+}
+
+IVector* ivector_drop(IVector *vector) {
+    return ivector_drop_n(vector, 1);
+}
+
+IVector* ivector_drop_back(IVector *vector) {
+    return ivector_drop_back_n(vector, 1);
+}
+
+IVector* ivector_drop_n(IVector *vector, int n) {
+    if (n >= vector->size) {
+        vector->size = 0;
+    } else if (n > 0) {
+        vector->size -= n;
+        memmove(vector->data, vector->data + n, vector->size * sizeof(int));
+    }
+    return vector;
+}
+
+IVector* ivector_drop_back_n(IVector *vector, int n) {
+    if (n >= vector->size) {
+        vector->size = 0;
+    } else if (n > 0) {
+        vector->size -= n;
+    }
+    return vector;
+}
+
+/* Returns the length of the longest prefix whose elements satisfy the predicate. */
+static int prefix_where(IVector *vector, const Callback *pred) {
+    int n = 0;
+    while (n < vector->size && apply(pred, vector->data[n])) {
+        n++;
+    }
+    return n;
+}
+
+/* Returns the start of the longest suffix whose elements satisfy the predicate. */
+static int suffix_where(IVector *vector, const Callback *pred) {
+    int start = vector->size;
+    while (start > 0 && apply(pred, vector->data[start - 1])) {
+        start--;
+    }
+    return start;
+}
+
+IVector* ivector_drop_while(IVector *vector, i_func pred) {
+    return ivector_drop_n(vector, prefix_where(vector, PLAIN(pred)));
+}
+
+IVector* ivector_drop_while_ctx(IVector *vector, i_func_ctx pred, void *ctx) {
+    return ivector_drop_n(vector, prefix_where(vector, WITH_CTX(pred, ctx)));
+}
+
+IVector* ivector_drop_back_while(IVector *vector, i_func pred) {
+    vector->size = suffix_where(vector, PLAIN(pred));
+    return vector;
+}
+
+IVector* ivector_drop_back_while_ctx(IVector *vector, i_func_ctx pred, void *ctx) {
+    vector->size = suffix_where(vector, WITH_CTX(pred, ctx));
+    return vector;
+}
+
+IVector* ivector_update(IVector *vector, int pos, int value) {
+    vector->data[pos] = value;
+    return vector;
+}
+
+IVector* ivector_sublist(IVector *vector, int start, int end) {
+    ivector_drop_back_n(vector, vector->size - end);
+    return ivector_drop_n(vector, start);
+}
+
+IVector* ivector_from_array(int size, int *arr) {
+    if (arr == NULL) {
+        return ivector_empty_list();
+    }
+    return copy_of(size, arr);
+}
+
+int* ivector_to_array(IVector *vector) {
+    int *arr = (int*) malloc(vector->size * sizeof(int));
+    memcpy(arr, vector->data, vector->size * sizeof(int));
+    return arr;
+}
+
+int ivector_to_array_into(IVector *vector, int *buf, int cap) {
+    int n = vector->size < cap ? vector->size : cap;
+    if (n <= 0) {
+        return 0;
+    }
+    memcpy(buf, vector->data, n * sizeof(int));
+    return n;
+}
+
+IVector* ivector_append_array(IVector *vector, int size, int *arr) {
+    if (size > 0) {
+        grow(vector, vector->size + size);
+        memcpy(vector->data + vector->size, arr, size * sizeof(int));
+        vector->size += size;
+    }
+    return vector;
+}
+
+IVectorBlocks ivector_blocks(IVector *vector, int block) {
+    return (IVectorBlocks) { vector->data, vector->size, block > 0 ? block : vector->size };
+}
+
+int ivector_next_block(IVectorBlocks *blocks, int **values) {
+    int n = blocks->left < blocks->block ? blocks->left : blocks->block;
+    *values = blocks->next;
+    if (n > 0) {
+        blocks->next += n;
+        blocks->left -= n;
+    }
+    return n > 0 ? n : 0;
+}
+
+IVector* ivector_adopt_array(int size, int *arr) {
+    IVector *vector = ivector_empty_list();
+    vector->data = arr;
+    vector->size = size;
+    vector->capacity = size;
+    return vector;
+}
+
+int* ivector_release_array(IVector **vector) {
+    int *arr = (*vector)->data;
+    free(*vector);
+    *vector = NULL;
+    return arr;
+}
+
+IVector* ivector_from_ilist(IList *list) {
+    return ivector_adopt_array(list->size, to_array(list));
+}
+
+IList* ivector_to_ilist(IVector *vector) {
+    return from_array(vector->size, vector->data);
+}
+
+void ivector_foreach(IVector *vector, void (*op)(int)) {
+    for (int i = 0; i < vector->size; i++) {
+        op(vector->data[i]);
+    }
+}
+
+void ivector_foreach_ctx(IVector *vector, void (*op)(int, void*), void *ctx) {
+    for (int i = 0; i < vector->size; i++) {
+        op(vector->data[i], ctx);
+    }
+}
+
+void ivector_print_list(IVector *vector) {
+    printf("IVector %p : [", vector);
+    for (int i = 0; i < vector->size; i++) {
+        printf(i < vector->size - 1 ? "%d, " : "%d", vector->data[i]);
+    }
+    printf("]\n");
+}
+
+IVector* ivector_reverse(IVector *vector) {
+    IVector *result = ivector_with_capacity(vector->size);
+    for (int i = 0; i < vector->size; i++) {
+        result->data[i] = vector->data[vector->size - 1 - i];
+    }
+    result->size = vector->size;
+    return result;
+}
+
+int ivector_get_first(IVector *vector) {
+    return vector->data[0];
+}
+
+int ivector_get_last(IVector *vector) {
+    return vector->data[vector->size - 1];
+}
+
+int ivector_get(IVector *vector, int index) {
+    return vector->data[index];
+}
+
+int ivector_find(IVector *vector, i_func pred) {
+    return ivector_find_or(vector, pred, 0);
+}
+
+int ivector_find_not(IVector *vector, i_func pred) {
+    return ivector_find_not_or(vector, pred, 0);
+}
+
+int ivector_find_ctx(IVector *vector, i_func_ctx pred, void *ctx) {
+    return ivector_find_or_ctx(vector, pred, 0, ctx);
+}
+
+int ivector_find_not_ctx(IVector *vector, i_func_ctx pred, void *ctx) {
+    return ivector_find_not_or_ctx(vector, pred, 0, ctx);
+}
+
+/* Returns the index of the first element for which the predicate is true (or false
+    if wanted is), or -1. */
+static int find_where(IVector *vector, const Callback *pred, int wanted) {
+    for (int i = 0; i < vector->size; i++) {
+        if (!apply(pred, vector->data[i]) == !wanted) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+int ivector_find_or(IVector *vector, i_func pred, int default_value) {
+    int i = find_where(vector, PLAIN(pred), 1);
+    return i != -1 ? vector->data[i] : default_value;
+}
+
+int ivector_find_not_or(IVector *vector, i_func pred, int default_value) {
+    int i = find_where(vector, PLAIN(pred), 0);
+    return i != -1 ? vector->data[i] : default_value;
+}
+
+int ivector_find_or_ctx(IVector *vector, i_func_ctx pred, int default_value, void *ctx) {
+    int i = find_where(vector, WITH_CTX(pred, ctx), 1);
+    return i != -1 ? vector->data[i] : default_value;
+}
+
+int ivector_find_not_or_ctx(IVector *vector, i_func_ctx pred, int default_value, void *ctx) {
+    int i = find_where(vector, WITH_CTX(pred, ctx), 0);
+    return i != -1 ? vector->data[i] : default_value;
+}
+
+int ivector_index_of(IVector *vector, int item) {
+    return index_of_array(vector->size, vector->data, item);
+}
+
+int ivector_last_index_of(IVector *vector, int item) {
+    return last_index_of_array(vector->size, vector->data, item);
+}
+
+IVector* ivector_clone(IVector *vector) {
+    return copy_of(vector->size, vector->data);
+}
+
+static IVector* map_with(IVector *vector, const Callback *op) {
+    for (int i = 0; i < vector->size; i++) {
+        vector->data[i] = apply(op, vector->data[i]);
+    }
+    return vector;
+}
+
+IVector* ivector_map(IVector *vector, i_func op) {
+    return map_with(vector, PLAIN(op));
+}
+
+IVector* ivector_map_ctx(IVector *vector, i_func_ctx op, void *ctx) {
+    return map_with(vector, WITH_CTX(op, ctx));
+}
+
+/* Returns a new vector of the elements for which the predicate is true (or false if keep is). */
+static IVector* filter_where(IVector *vector, const Callback *pred, int keep) {
+    IVector *result = ivector_empty_list();
+    for (int i = 0; i < vector->size; i++) {
+        if (!apply(pred, vector->data[i]) == !keep) {
+            ivector_push_back(result, vector->data[i]);
+        }
+    }
+    return result;
+}
+
+IVector* ivector_filter(IVector *vector, i_func pred) {
+    return filter_where(vector, PLAIN(pred), 1);
+}
+
+IVector* ivector_filter_not(IVector *vector, i_func pred) {
+    return filter_where(vector, PLAIN(pred), 0);
+}
+
+IVector* ivector_filter_ctx(IVector *vector, i_func_ctx pred, void *ctx) {
+    return filter_where(vector, WITH_CTX(pred, ctx), 1);
+}
+
+IVector* ivector_filter_not_ctx(IVector *vector, i_func_ctx pred, void *ctx) {
+    return filter_where(vector, WITH_CTX(pred, ctx), 0);
+}
+
+IVector* ivector_add_all(IVector *vector, IVector *elems) {
+    int n = elems->size;
+    grow(vector, vector->size + n);
+    memmove(vector->data + vector->size, elems->data, n * sizeof(int));
+    vector->size += n;
+    return vector;
+}
+
+int ivector_contains(IVector *vector, int value) {
+    return contains_array(vector->size, vector->data, value);
+}
+
+/* Applies the operator to the accumulator and each element from the index on, going left to right. */
+static int fold_from(int init, IVector *vector, int from, const BiCallback *op) {
+    int acc = init;
+    for (int i = from; i < vector->size; i++) {
+        acc = combine(op, acc, vector->data[i]);
+    }
+    return acc;
+}
+
+/* Applies the operator to each element from the index back and the accumulator,
+    going right to left. */
+static int fold_back(int init, IVector *vector, int from, const BiCallback *op) {
+    int acc = init;
+    for (int i = from; i >= 0; i--) {
+        acc = combine(op, vector->data[i], acc);
+    }
+    return acc;
+}
+
+int ivector_fold_left(int init, IVector *vector, i_bifunc op) {
+    return fold_from(init, vector, 0, PLAIN2(op));
+}
+
+int ivector_reduce_left(IVector *vector, i_bifunc op) {
+    return ivector_is_empty(vector) ? 0 : fold_from(vector->data[0], vector, 1, PLAIN2(op));
+}
+
+int ivector_fold_right(int init, IVector *vector, i_bifunc op) {
+    return fold_back(init, vector, vector->size - 1, PLAIN2(op));
+}
+
+int ivector_reduce_right(IVector *vector, i_bifunc op) {
+    if (ivector_is_empty(vector)) {
+        return 0;
+    }
+    return fold_back(vector->data[vector->size - 1], vector, vector->size - 2, PLAIN2(op));
+}
+
+int ivector_fold_left_ctx(int init, IVector *vector, i_bifunc_ctx op, void *ctx) {
+    return fold_from(init, vector, 0, WITH_CTX2(op, ctx));
+}
+
+int ivector_reduce_left_ctx(IVector *vector, i_bifunc_ctx op, void *ctx) {
+    return ivector_is_empty(vector) ? 0 : fold_from(vector->data[0], vector, 1, WITH_CTX2(op, ctx));
+}
+
+int ivector_fold_right_ctx(int init, IVector *vector, i_bifunc_ctx op, void *ctx) {
+    return fold_back(init, vector, vector->size - 1, WITH_CTX2(op, ctx));
+}
+
+int ivector_reduce_right_ctx(IVector *vector, i_bifunc_ctx op, void *ctx) {
+    if (ivector_is_empty(vector)) {
+        return 0;
+    }
+    return fold_back(vector->data[vector->size - 1], vector, vector->size - 2, WITH_CTX2(op, ctx));
+}
+
+IVector* ivector_take(IVector *vector, int n) {
+    return ivector_slice(vector, 0, n - 1);
+}
+
+IVector* ivector_take_while(IVector *vector, i_func pred) {
+    return copy_of(prefix_where(vector, PLAIN(pred)), vector->data);
+}
+
+IVector* ivector_take_while_ctx(IVector *vector, i_func_ctx pred, void *ctx) {
+    return copy_of(prefix_where(vector, WITH_CTX(pred, ctx)), vector->data);
+}
+
+IVector* ivector_take_right(IVector *vector, int n) {
+    return ivector_slice(vector, vector->size - n, vector->size - 1);
+}
+
+IVector* ivector_take_right_while(IVector *vector, i_func pred) {
+    int start = suffix_where(vector, PLAIN(pred));
+    return copy_of(vector->size - start, vector->data + start);
+}
+
+IVector* ivector_take_right_while_ctx(IVector *vector, i_func_ctx pred, void *ctx) {
+    int start = suffix_where(vector, WITH_CTX(pred, ctx));
+    return copy_of(vector->size - start, vector->data + start);
+}
+
+IVector* ivector_slice(IVector *vector, int start, int end) {
+    if (start < 0) {
+        start = 0;
+    }
+    if (end > vector->size - 1) {
+        end = vector->size - 1;
+    }
+    return copy_of(end - start + 1, vector->data + start);
+}
+
+static int count_where(IVector *vector, const Callback *pred) {
+    int count = 0;
+    for (int i = 0; i < vector->size; i++) {
+        if (apply(pred, vector->data[i])) {
+            count++;
+        }
+    }
+    return count;
+}
+
+int ivector_forall(IVector *vector, i_func pred) {
+    return find_where(vector, PLAIN(pred), 0) == -1;
+}
+
+int ivector_exists(IVector *vector, i_func pred) {
+    return find_where(vector, PLAIN(pred), 1) != -1;
+}
+
+int ivector_count(IVector *vector, i_func pred) {
+    return count_where(vector, PLAIN(pred));
+}
+
+int ivector_forall_ctx(IVector *vector, i_func_ctx pred, void *ctx) {
+    return find_where(vector, WITH_CTX(pred, ctx), 0) == -1;
+}
+
+int ivector_exists_ctx(IVector *vector, i_func_ctx pred, void *ctx) {
+    return find_where(vector, WITH_CTX(pred, ctx), 1) != -1;
+}
+
+int ivector_count_ctx(IVector *vector, i_func_ctx pred, void *ctx) {
+    return count_where(vector, WITH_CTX(pred, ctx));
+}
+
+IVector* ivector_unique(IVector *vector) {
+    IVector *result = ivector_empty_list();
+    ISet *seen = iset_empty(vector->size);
+    for (int i = 0; i < vector->size; i++) {
+        if (iset_add(seen, vector->data[i])) {
+            ivector_push_back(result, vector->data[i]);
+        }
+    }
+    iset_delete(&seen);
+    return result;
+}
+
+IVector* ivector_distinct(IVector *vector) {
+    int size = 0;
+    ISet *seen = iset_empty(vector->size);
+    for (int i = 0; i < vector->size; i++) {
+        if (iset_add(seen, vector->data[i])) {
+            vector->data[size++] = vector->data[i];
+        }
+    }
+    iset_delete(&seen);
+    vector->size = size;
+    return vector;
+}
+
+IVector* ivector_swap(IVector *vector, int i, int j) {
+    int vi = vector->data[i];
+    vector->data[i] = vector->data[j];
+    vector->data[j] = vi;
+    return vector;
+}
+
+int ivector_is_prefix(IVector *vector, IVector *prefix) {
+    return prefix->size <= vector->size
+        && (prefix->size == 0 || memcmp(vector->data, prefix->data, prefix->size * sizeof(int)) == 0);
+}
+
+int ivector_is_suffix(IVector *vector, IVector *suffix) {
+    return suffix->size <= vector->size
+        && (suffix->size == 0 || memcmp(vector->data + vector->size - suffix->size, suffix->data,
+                suffix->size * sizeof(int)) == 0);
+}
+
+int ivector_is_sublist(IVector *vector, IVector *sublist) {
+    if (sublist->size == 0) {
+        return 1;
+    }
+    for (int i = 0; i + sublist->size <= vector->size; i++) {
+        if (memcmp(vector->data + i, sublist->data, sublist->size * sizeof(int)) == 0) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+IVector* ivector_intersperse(IVector *vector, int value) {
+    IVector *result = ivector_empty_list();
+    if (ivector_is_not_empty(vector)) {
+        grow(result, vector->size * 2 - 1);
+        for (int i = 0; i < vector->size; i++) {
+            if (i > 0) {
+                result->data[result->size++] = value;
+            }
+            result->data[result->size++] = vector->data[i];
+        }
+    }
+    return result;
+}
+
+int ivector_max(IVector *vector) {
+    return max_array(vector->size, vector->data);
+}
+
+int ivector_min(IVector *vector) {
+    return min_array(vector->size, vector->data);
+}
+
+int ivector_sum(IVector *vector) {
+    return sum_array(vector->size, vector->data);
+}
+
+long long ivector_sum64(IVector *vector) {
+    return sum64_array(vector->size, vector->data);
+}
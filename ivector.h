@@ -0,0 +1,340 @@
+#ifndef IVECTOR_H_
+#define IVECTOR_H_
+
+#include "ilist.h"
+
+/* Integer Vector (growable array) */
+
+typedef struct {
+    int *data;
+    int size;
+    int capacity;
+} IVector;
+
+/* Reads the values of a vector in spans of its own storage (see ivector_blocks). */
+typedef struct {
+    int *next;
+    int left;
+    int block;
+} IVectorBlocks;
+
+/* Returns true if this vector contains some elements. */
+extern int ivector_is_empty(IVector*);
+
+/* Returns true if this vector contains no elements. */
+extern int ivector_is_not_empty(IVector*);
+
+/* Returns an empty vector. */
+extern IVector* ivector_empty_list();
+
+/* Returns an empty vector with room for the specified number of elements. */
+extern IVector* ivector_with_capacity(int);
+
+/* Returns a vector containing only the specified object. */
+extern IVector* ivector_single_list_of(int);
+
+/* Returns a vector containing an arbitrary number of elements. */
+extern IVector* ivector_list_of(int, ...);
+
+/* Returns a sequential ordered IVector from start (inclusive)
+    to end (inclusive) by an incremental step of 1 (or -1). */
+extern IVector* ivector_range(int, int);
+
+/* Returns a sequential ordered IVector from start (inclusive)
+    to end (inclusive) by a specified step. */
+extern IVector* ivector_range_step(int, int, int);
+
+/* Returns a sequential ordered IVector from start (inclusive)
+    to end (exclusive) by an incremental step of 1 (or -1). */
+extern IVector* ivector_range_ex(int, int);
+
+/* Returns a sequential ordered IVector from start (inclusive)
+    to end (exclusive) by a specified step. */
+extern IVector* ivector_range_step_ex(int, int, int);
+
+/* Returns a vector of n elements produced by iterative application
+    of a function to an initial element. */
+extern IVector* ivector_generate_n(int, i_func, int);
+
+/* ivector_generate_n with a function that receives the context. */
+extern IVector* ivector_generate_n_ctx(int, i_func_ctx, int, void*);
+
+/* Returns a vector produced by iterative application of a function
+    to an initial element while the condition is satisfied. */
+extern IVector* ivector_generate_while(int, i_func, i_func);
+
+/* ivector_generate_while with a function and a condition that receive the context. */
+extern IVector* ivector_generate_while_ctx(int, i_func_ctx, i_func_ctx, void*);
+
+/* Returns a vector consisting of n copies of the specified object. */
+extern IVector* ivector_repeat(int, int);
+
+/* Delete the vector. */
+extern void ivector_delete_list(IVector**);
+
+/* Returns true if the arguments are equal to each other and false otherwise. */
+extern int ivector_equals(IVector*, IVector*);
+
+/* Returns a size of the vector. */
+extern int ivector_get_size(IVector*);
+
+/* Returns the number of elements the vector can hold without reallocation. */
+extern int ivector_get_capacity(IVector*);
+
+/* Ensures that the vector can hold the specified number of elements without reallocation. */
+extern IVector* ivector_reserve(IVector*, int);
+
+/* Releases unused capacity of the vector. */
+extern IVector* ivector_shrink_to_fit(IVector*);
+
+/* [Mutator] Pushes an element onto the stack represented by this vector.
+    (Inserts the specified element at the beginning of this vector.) */
+extern IVector* ivector_push(IVector*, int);
+
+/* [Mutator] Appends the specified element to the end of this vector. */
+extern IVector* ivector_push_back(IVector*, int);
+
+/* [Mutator] Inserts the specified element at the position of this vector. */
+extern IVector* ivector_insert(IVector*, int, int);
+
+/* [Mutator] Pops an element from the stack represented by this vector.
+    (Removes and returns the first element from this vector.) */
+extern int ivector_pop(IVector*);
+
+/* [Mutator] Removes and returns the last element from this vector. */
+extern int ivector_pop_back(IVector*);
+
+/* [Mutator] Removes the element at the specified position in this vector. */
+extern IVector* ivector_delete(IVector*, int);
+
+/* [Mutator] Removes all occurrences of the specified element from this vector. */
+extern IVector* ivector_delete_item(IVector*, int);
+
+/* [Mutator] Removes the first element from this vector. */
+extern IVector* ivector_drop(IVector*);
+
+/* [Mutator] Removes the last element from this vector. */
+extern IVector* ivector_drop_back(IVector*);
+
+/* [Mutator] Removes first n elements from this vector. */
+extern IVector* ivector_drop_n(IVector*, int);
+
+/* [Mutator] Removes last n elements from this vector. */
+extern IVector* ivector_drop_back_n(IVector*, int);
+
+/* [Mutator] Removes first elements from this vector while the condition is satisfied. */
+extern IVector* ivector_drop_while(IVector*, i_func);
+
+/* [Mutator] ivector_drop_while with a predicate that receives the context. */
+extern IVector* ivector_drop_while_ctx(IVector*, i_func_ctx, void*);
+
+/* [Mutator] Removes last elements from this vector while the condition is satisfied. */
+extern IVector* ivector_drop_back_while(IVector*, i_func);
+
+/* [Mutator] ivector_drop_back_while with a predicate that receives the context. */
+extern IVector* ivector_drop_back_while_ctx(IVector*, i_func_ctx, void*);
+
+/* [Mutator] Replaces the element at the specified position in this vector
+    with the specified value. */
+extern IVector* ivector_update(IVector*, int, int);
+
+/* [Mutator] Returns sublist. */
+extern IVector* ivector_sublist(IVector*, int, int);
+
+/* Returns a vector containing elements of the array. */
+extern IVector* ivector_from_array(int, int*);
+
+/* Returns an array containing elements of the vector. */
+extern int* ivector_to_array(IVector*);
+
+/* Copies up to cap elements of the vector into the buffer and returns their number. */
+extern int ivector_to_array_into(IVector*, int*, int);
+
+/* [Mutator] Appends the specified count of elements from the array to the end of this vector. */
+extern IVector* ivector_append_array(IVector*, int, int*);
+
+/* Returns a reader of the values of the vector in spans of up to block values
+    (all of them in one span if block is not positive). */
+extern IVectorBlocks ivector_blocks(IVector*, int);
+
+/* Stores into the pointer the next span of values and returns its length,
+    or 0 after the last span. The values are not copied; the vector must not
+    change while it is read. */
+extern int ivector_next_block(IVectorBlocks*, int**);
+
+/* Returns a vector that takes ownership of a malloc'ed array without copying it. */
+extern IVector* ivector_adopt_array(int, int*);
+
+/* Deletes the vector and returns its array, which the caller must free. */
+extern int* ivector_release_array(IVector**);
+
+/* Returns a vector containing elements of the list (one allocation for the elements). */
+extern IVector* ivector_from_ilist(IList*);
+
+/* Returns a list containing elements of the vector. */
+extern IList* ivector_to_ilist(IVector*);
+
+/* Performs the given action for each element of the vector. */
+extern void ivector_foreach(IVector*, void (*op)(int));
+
+/* ivector_foreach with an action that receives the context. */
+extern void ivector_foreach_ctx(IVector*, void (*op)(int, void*), void*);
+
+/* Print the vector. */
+extern void ivector_print_list(IVector*);
+
+/* Returns new vector with elements in reversed order. */
+extern IVector* ivector_reverse(IVector*);
+
+/* Returns a first value of the vector. */
+extern int ivector_get_first(IVector*);
+
+/* Returns a last value of the vector. */
+extern int ivector_get_last(IVector*);
+
+/* Returns a value of the vector at the specified position. */
+extern int ivector_get(IVector*, int);
+
+/* Finds the first element of the vector a predicate. */
+extern int ivector_find(IVector*, i_func);
+
+/* Finds the first element of the vector a negative predicate. */
+extern int ivector_find_not(IVector*, i_func);
+
+/* Finds the first element of the vector a predicate or returns default value. */
+extern int ivector_find_or(IVector*, i_func, int);
+
+/* Finds the first element of the vector a negative predicate or returns default value. */
+extern int ivector_find_not_or(IVector*, i_func, int);
+
+/* ivector_find, ivector_find_not, ivector_find_or and ivector_find_not_or with a predicate that receives
+    the context. */
+extern int ivector_find_ctx(IVector*, i_func_ctx, void*);
+extern int ivector_find_not_ctx(IVector*, i_func_ctx, void*);
+extern int ivector_find_or_ctx(IVector*, i_func_ctx, int, void*);
+extern int ivector_find_not_or_ctx(IVector*, i_func_ctx, int, void*);
+
+/* Returns the index of the first occurrence of the specified element in this vector,
+    or -1 if this vector does not contain the element. */
+extern int ivector_index_of(IVector*, int);
+
+/* Returns the index of the last occurrence of the specified element in this vector,
+    or -1 if this vector does not contain the element. */
+extern int ivector_last_index_of(IVector*, int);
+
+/* Returns a copy of this. */
+extern IVector* ivector_clone(IVector*);
+
+/* Returns a vector consisting of the results of applying the given function
+    to the elements of this vector. */
+extern IVector* ivector_map(IVector*, i_func);
+
+/* ivector_map with a function that receives the context. */
+extern IVector* ivector_map_ctx(IVector*, i_func_ctx, void*);
+
+/* Returns a vector consisting of the elements of this vector that match the given predicate. */
+extern IVector* ivector_filter(IVector*, i_func);
+
+/* Returns a vector consisting of the elements of this vector that
+    match the negation given predicate. */
+extern IVector* ivector_filter_not(IVector*, i_func);
+
+/* ivector_filter and ivector_filter_not with a predicate that receives the context. */
+extern IVector* ivector_filter_ctx(IVector*, i_func_ctx, void*);
+extern IVector* ivector_filter_not_ctx(IVector*, i_func_ctx, void*);
+
+/* [Mutator] Appends all of the elements in the second collection to the end of first vector. */
+extern IVector* ivector_add_all(IVector*, IVector*);
+
+/* Returns true if the vector contains the specified element. */
+extern int ivector_contains(IVector*, int);
+
+/* Applies a binary operator to a start value and all elements of the vector, going left to right. */
+extern int ivector_fold_left(int, IVector*, i_bifunc);
+
+/* Applies a binary operator to all elements of the vector, going left to right. */
+extern int ivector_reduce_left(IVector*, i_bifunc);
+
+/* Applies a binary operator to all elements of the vector and a start value, going right to left. */
+extern int ivector_fold_right(int, IVector*, i_bifunc);
+
+/* Applies a binary operator to all elements of the vector, going right to left. */
+extern int ivector_reduce_right(IVector*, i_bifunc);
+
+/* The folds and reductions with an operator that receives the context. */
+extern int ivector_fold_left_ctx(int, IVector*, i_bifunc_ctx, void*);
+extern int ivector_reduce_left_ctx(IVector*, i_bifunc_ctx, void*);
+extern int ivector_fold_right_ctx(int, IVector*, i_bifunc_ctx, void*);
+extern int ivector_reduce_right_ctx(IVector*, i_bifunc_ctx, void*);
+
+/* Selects first n elements. */
+extern IVector* ivector_take(IVector*, int);
+
+/* Takes longest prefix of elements that satisfy a predicate. */
+extern IVector* ivector_take_while(IVector*, i_func);
+
+/* ivector_take_while with a predicate that receives the context. */
+extern IVector* ivector_take_while_ctx(IVector*, i_func_ctx, void*);
+
+/* Selects last n elements. */
+extern IVector* ivector_take_right(IVector*, int);
+
+/* Takes longest suffix of elements that satisfy a predicate. */
+extern IVector* ivector_take_right_while(IVector*, i_func);
+
+/* ivector_take_right_while with a predicate that receives the context. */
+extern IVector* ivector_take_right_while_ctx(IVector*, i_func_ctx, void*);
+
+/* Returns a vector containing the elements greater than or equal to index from extending up
+    to index until of the vector. */
+extern IVector* ivector_slice(IVector*, int, int);
+
+/* Tests whether a predicate holds for all elements of the vector. */
+extern int ivector_forall(IVector*, i_func);
+
+/* Tests whether a predicate holds for at least one element of the vector. */
+extern int ivector_exists(IVector*, i_func);
+
+/* Counts the number of elements in the vector which satisfy a predicate. */
+extern int ivector_count(IVector*, i_func);
+
+/* ivector_forall, ivector_exists and ivector_count with a predicate that receives the context. */
+extern int ivector_forall_ctx(IVector*, i_func_ctx, void*);
+extern int ivector_exists_ctx(IVector*, i_func_ctx, void*);
+extern int ivector_count_ctx(IVector*, i_func_ctx, void*);
+
+/* Builds a new vector from the vector without any duplicate elements. */
+extern IVector* ivector_unique(IVector*);
+
+/* [Mutator] Returns a vector consisting only of the distinct elements (according to ==). */
+extern IVector* ivector_distinct(IVector*);
+
+/* [Mutator] Swap values of two elements in the vector. */
+extern IVector* ivector_swap(IVector*, int, int);
+
+/* Returns true iff the first vector is a prefix of the second. */
+extern int ivector_is_prefix(IVector*, IVector*);
+
+/* Returns true iff the first vector is a suffix of the second. */
+extern int ivector_is_suffix(IVector*, IVector*);
+
+/* Returns true iff the first vector is a sublist of the second. */
+extern int ivector_is_sublist(IVector*, IVector*);
+
+/* Returns a new vector containing elements that `interspersed`
+    by the element between the elements of the vector. */
+extern IVector* ivector_intersperse(IVector*, int);
+
+/* Finds the largest element. */
+extern int ivector_max(IVector*);
+
+/* Finds the smallest element. */
+extern int ivector_min(IVector*);
+
+/* Sums up the elements of the vector. */
+extern int ivector_sum(IVector*);
+
+/* Sums up the elements of the vector into a 64-bit accumulator. */
+extern long long ivector_sum64(IVector*);
+
+#endif
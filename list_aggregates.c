@@ -0,0 +1,109 @@
+#include <stdlib.h>
+#include "list_aggregates.h"
+
+ListAggregates* new_list_aggregates() {
+    return (ListAggregates*) calloc(1, sizeof(ListAggregates));
+}
+
+void delete_list_aggregates(ListAggregates **aggregates) {
+    free(*aggregates);
+    *aggregates = NULL;
+}
+
+void aggregates_rebuild(ListAggregates *aggregates, IList *list) {
+    long long sum = 0;
+    int min = list->first ? list->first->value : 0;
+    int max = min;
+    int sorted = 1;
+    for (Node *cur = list->first; cur; cur = cur->next) {
+        sum += cur->value;
+        if (cur->value < min) {
+            min = cur->value;
+        }
+        if (cur->value > max) {
+            max = cur->value;
+        }
+        if (cur->next && cur->next->value < cur->value) {
+            sorted = 0;
+        }
+    }
+    aggregates->sum = sum;
+    aggregates->min = min;
+    aggregates->max = max;
+    aggregates->sorted = sorted;
+    aggregates->sum_valid = 1;
+    /* an empty list has no extremes: they stay stale until it has elements */
+    aggregates->min_valid = list->first != NULL;
+    aggregates->max_valid = list->first != NULL;
+    aggregates->sorted_valid = 1;
+}
+
+void aggregates_added(ListAggregates *aggregates, int value) {
+    aggregates->sum += value;
+    if (aggregates->min_valid && value < aggregates->min) {
+        aggregates->min = value;
+    }
+    if (aggregates->max_valid && value > aggregates->max) {
+        aggregates->max = value;
+    }
+}
+
+void aggregates_removed(ListAggregates *aggregates, int value) {
+    aggregates->sum -= value;
+    if (value == aggregates->min) {
+        aggregates->min_valid = 0;
+    }
+    if (value == aggregates->max) {
+        aggregates->max_valid = 0;
+    }
+    /* removing from an unordered list may leave it in order */
+    if (!aggregates->sorted) {
+        aggregates->sorted_valid = 0;
+    }
+}
+
+void aggregates_adjacent(ListAggregates *aggregates, int before, int after) {
+    if (before > after) {
+        aggregates->sorted = 0;
+    }
+}
+
+void aggregates_reordered(ListAggregates *aggregates, int ascending) {
+    aggregates->sorted = ascending;
+    aggregates->sorted_valid = ascending;
+}
+
+void aggregates_invalidate(ListAggregates *aggregates) {
+    aggregates->sum_valid = 0;
+    aggregates->min_valid = 0;
+    aggregates->max_valid = 0;
+    aggregates->sorted_valid = 0;
+}
+
+long long aggregates_sum(ListAggregates *aggregates, IList *list) {
+    if (!aggregates->sum_valid) {
+        aggregates_rebuild(aggregates, list);
+    }
+    return aggregates->sum;
+}
+
+int aggregates_min(ListAggregates *aggregates, IList *list) {
+    if (!aggregates->min_valid) {
+        aggregates_rebuild(aggregates, list);
+    }
+    return aggregates->min;
+}
+
+int aggregates_max(ListAggregates *aggregates, IList *list) {
+    if (!aggregates->max_valid) {
+        aggregates_rebuild(aggregates, list);
+    }
+    return aggregates->max;
+}
+
+int aggregates_sorted(ListAggregates *aggregates, IList *list) {
+    if (!aggregates->sorted_valid) {
+        aggregates_rebuild(aggregates, list);
+    }
+    return aggregates->sorted;
+}
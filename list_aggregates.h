@@ -0,0 +1,56 @@
+#ifndef LIST_AGGREGATES_H_
+#define LIST_AGGREGATES_H_
+
+#include "ilist.h"
+
+/* Tracked aggregates for lists
+
+    Keeps the sum, minimum and maximum of the elements and whether they are
+    in ascending order. Mutators report values as they are added and removed,
+    so the sum stays exact; removing the current minimum or maximum, or a
+    change that is not reported value by value, marks the affected parts
+    stale, and the next query rebuilds them in one pass. */
+
+struct ListAggregates {
+    long long sum;
+    int min;
+    int max;
+    int sorted;
+    int sum_valid;
+    int min_valid;
+    int max_valid;
+    int sorted_valid;
+};
+
+/* Returns aggregates that are rebuilt on the first query. */
+extern ListAggregates* new_list_aggregates();
+
+/* Delete the aggregates. */
+extern void delete_list_aggregates(ListAggregates**);
+
+/* Rebuilds all aggregates from the elements of the list in one pass. */
+extern void aggregates_rebuild(ListAggregates*, IList*);
+
+/* Records that the value was added to the list. */
+extern void aggregates_added(ListAggregates*, int);
+
+/* Records that the value was removed from the list. */
+extern void aggregates_removed(ListAggregates*, int);
+
+/* Records that the value before was placed right in front of the value after. */
+extern void aggregates_adjacent(ListAggregates*, int, int);
+
+/* Records that the order of the elements changed in an unknown way,
+    or that it is now ascending if the second argument is true. */
+extern void aggregates_reordered(ListAggregates*, int);
+
+/* Forgets all aggregates, for changes that are not reported value by value. */
+extern void aggregates_invalidate(ListAggregates*);
+
+/* Queries; each rebuilds the aggregates first if the part it needs is stale. */
+extern long long aggregates_sum(ListAggregates*, IList*);
+extern int aggregates_min(ListAggregates*, IList*);
+extern int aggregates_max(ListAggregates*, IList*);
+extern int aggregates_sorted(ListAggregates*, IList*);
+
+#endif
@@ -0,0 +1,133 @@
+#include <stdlib.h>
+#include <string.h>
+#include "list_index.h"
+#include "istats.h"
+
+#define MIN_STRIDE 16
+
+ListIndex* new_list_index() {
+    return (ListIndex*) calloc(1, sizeof(ListIndex));
+}
+
+void delete_list_index(ListIndex **index) {
+    free((*index)->skips);
+    free(*index);
+    *index = NULL;
+}
+
+void index_rebuild(ListIndex *index, IList *list) {
+    int stride = MIN_STRIDE;
+    while ((long long) stride * stride < list->size) {
+        stride *= 2;
+    }
+    int count = (list->size + stride - 1) / stride;
+    if (count > index->capacity) {
+        index->capacity = count;
+        index->skips = (Skip*) realloc(index->skips, count * sizeof(Skip));
+    }
+    int i = 0;
+    int pos = 0;
+    for (Node *cur = list->first; cur; cur = cur->next, pos++) {
+        if (pos % stride == 0) {
+            index->skips[i].node = cur;
+            index->skips[i].pos = pos;
+            i++;
+        }
+    }
+    index->count = i;
+    index->stride = stride;
+    index->shift = 0;
+    index->valid = 1;
+}
+
+/* Returns the index of the last skip at or before the position, or -1 if there is none. */
+static int find_skip(ListIndex *index, int pos) {
+    int lo = 0;
+    int hi = index->count - 1;
+    int found = -1;
+    pos -= index->shift;
+    while (lo <= hi) {
+        int mid = lo + (hi - lo) / 2;
+        if (index->skips[mid].pos <= pos) {
+            found = mid;
+            lo = mid + 1;
+        } else {
+            hi = mid - 1;
+        }
+    }
+    return found;
+}
+
+Node* index_get_node(ListIndex *index, IList *list, int pos) {
+    if (!index->valid) {
+        index_rebuild(index, list);
+    }
+    Node *cur = list->first;
+    int at = 0;
+    int skip = find_skip(index, pos);
+    if (skip >= 0) {
+        cur = index->skips[skip].node;
+        at = index->skips[skip].pos + index->shift;
+    }
+    if (pos - at > 2 * index->stride) {
+        /* insertions have spread the skips apart */
+        index->valid = 0;
+    }
+    if (index->finger && index->finger_pos <= pos && index->finger_pos > at) {
+        cur = index->finger;
+        at = index->finger_pos;
+    }
+    STATS_STEPS(list, pos - at);
+    for (; at < pos; at++) {
+        cur = cur->next;
+    }
+    index->finger = cur;
+    index->finger_pos = pos;
+    return cur;
+}
+
+void index_inserted(ListIndex *index, int pos, int n) {
+    if (index->finger && index->finger_pos >= pos) {
+        index->finger_pos += n;
+    }
+    if (!index->valid) {
+        return;
+    }
+    if (pos == 0) {
+        index->shift += n;
+        return;
+    }
+    for (int i = find_skip(index, pos - 1) + 1; i < index->count; i++) {
+        index->skips[i].pos += n;
+    }
+}
+
+void index_removed(ListIndex *index, int pos, Node *node) {
+    if (index->finger == node) {
+        index->finger = NULL;
+    } else if (index->finger && index->finger_pos > pos) {
+        index->finger_pos--;
+    }
+    if (!index->valid) {
+        return;
+    }
+    int i = find_skip(index, pos);
+    if (i >= 0 && index->skips[i].node == node) {
+        memmove(&index->skips[i], &index->skips[i + 1], (index->count - i - 1) * sizeof(Skip));
+        index->count--;
+    } else {
+        i++;
+    }
+    if (pos == 0) {
+        index->shift--;
+        return;
+    }
+    for (; i < index->count; i++) {
+        index->skips[i].pos--;
+    }
+}
+
+void index_invalidate(ListIndex *index) {
+    index->valid = 0;
+    index->finger = NULL;
+}
@@ -0,0 +1,54 @@
+#ifndef LIST_INDEX_H_
+#define LIST_INDEX_H_
+
+#include "ilist.h"
+
+/* Positional index for lists
+
+    Keeps skip entries (a node and its position) roughly every stride nodes,
+    with stride about sqrt(size), plus a finger on the last looked up node.
+    A lookup binary searches the skips and walks at most about one stride,
+    or walks forward from the finger when that is closer.
+
+    Mutators report single insertions and removals so the entries shift in
+    place; other structural changes invalidate the index, which is rebuilt
+    in one pass on the next lookup. */
+
+typedef struct {
+    Node *node;
+    int pos;
+} Skip;
+
+struct ListIndex {
+    Skip *skips;
+    int count;
+    int capacity;
+    int stride;
+    int shift;
+    int valid;
+    Node *finger;
+    int finger_pos;
+};
+
+/* Returns an empty index, built on the first lookup. */
+extern ListIndex* new_list_index();
+
+/* Rebuilds the index from the nodes of the list in one pass. */
+extern void index_rebuild(ListIndex*, IList*);
+
+/* Delete the index. */
+extern void delete_list_index(ListIndex**);
+
+/* Returns the node of the list at the position, which must be in range. */
+extern Node* index_get_node(ListIndex*, IList*, int);
+
+/* Records that n nodes were inserted at the position. */
+extern void index_inserted(ListIndex*, int, int);
+
+/* Records that the node at the position is about to be removed. Its next link must still be intact. */
+extern void index_removed(ListIndex*, int, Node*);
+
+/* Forgets all positions, for changes that are not reported one node at a time. */
+extern void index_invalidate(ListIndex*);
+
+#endif
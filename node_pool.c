@@ -0,0 +1,71 @@
+#include <stdlib.h>
+#include "node_pool.h"
+
+#define DEFAULT_SLAB_SIZE 1024
+
+NodePool* new_pool(int slab_size) {
+    NodePool *pool = (NodePool*) malloc(sizeof(NodePool));
+    pool->slabs = NULL;
+    pool->free = NULL;
+    pool->slab_size = slab_size > 0 ? slab_size : DEFAULT_SLAB_SIZE;
+    pool->used = pool->slab_size;
+    pool->shared = 0;
+    pool->lists = 0;
+    return pool;
+}
+
+NodePool* new_shared_pool() {
+    NodePool *pool = new_pool(0);
+    pool->shared = 1;
+    return pool;
+}
+
+void delete_pool(NodePool **pool) {
+    Slab *slab = (*pool)->slabs;
+    while (slab) {
+        Slab *next = slab->next;
+        free(slab);
+        slab = next;
+    }
+    free(*pool);
+    *pool = NULL;
+}
+
+Node* pool_alloc(NodePool *pool) {
+    if (pool->free) {
+        Node *node = pool->free;
+        pool->free = node->next;
+        return node;
+    }
+    if (pool->used == pool->slab_size) {
+        Slab *slab = (Slab*) malloc(sizeof(Slab) + pool->slab_size * sizeof(Node));
+        slab->next = pool->slabs;
+        pool->slabs = slab;
+        pool->used = 0;
+    }
+    return &pool->slabs->nodes[pool->used++];
+}
+
+Node* pool_alloc_n(NodePool *pool, int count) {
+    Slab *slab = (Slab*) malloc(sizeof(Slab) + count * sizeof(Node));
+    if (pool->slabs && pool->used < pool->slab_size) {
+        /* pool_alloc keeps taking nodes from the partly used slab in front */
+        slab->next = pool->slabs->next;
+        pool->slabs->next = slab;
+    } else {
+        slab->next = pool->slabs;
+        pool->slabs = slab;
+        pool->used = pool->slab_size;
+    }
+    return slab->nodes;
+}
+
+void pool_free(NodePool *pool, Node *node) {
+    node->next = pool->free;
+    pool->free = node;
+}
+
+void pool_free_chain(NodePool *pool, Node *first, Node *last) {
+    last->next = pool->free;
+    pool->free = first;
+}
@@ -0,0 +1,45 @@
+#ifndef NODE_POOL_H_
+#define NODE_POOL_H_
+
+#include "ilist.h"
+
+/* Slab allocator for list nodes */
+
+typedef struct Slab {
+    struct Slab *next;
+    Node nodes[];
+} Slab;
+
+struct NodePool {
+    Slab *slabs;
+    Node *free;
+    int slab_size;
+    int used;
+    int shared;
+    int lists;
+};
+
+/* Returns a pool that allocates nodes in slabs of the specified size. */
+extern NodePool* new_pool(int);
+
+/* Returns a pool owned by the lists that use it: every list created in it
+    is counted, and delete_list deletes the pool with the last of them. A list
+    built in bulk keeps its pool to itself; lists derived from it do not use it. */
+extern NodePool* new_shared_pool();
+
+/* Delete the pool and every node allocated from it. */
+extern void delete_pool(NodePool**);
+
+/* Returns a node taken from the pool. */
+extern Node* pool_alloc(NodePool*);
+
+/* Returns an array of count nodes from a slab of their own. */
+extern Node* pool_alloc_n(NodePool*, int);
+
+/* Returns the node to the pool. */
+extern void pool_free(NodePool*, Node*);
+
+/* Returns a linked chain of nodes (from the first to the last) to the pool. */
+extern void pool_free_chain(NodePool*, Node*, Node*);
+
+#endif
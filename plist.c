@@ -0,0 +1,274 @@
+#include <stdlib.h>
+#include "plist.h"
+#include "icallback.h"
+
+/* Returns a cell holding the value in front of the rest, whose reference it takes over. */
+static PList* new_cell(int value, PList *rest) {
+    PList *cell = (PList*) malloc(sizeof(PList));
+    cell->value = value;
+    cell->refs = 1;
+    cell->size = plist_get_size(rest) + 1;
+    cell->next = rest;
+    return cell;
+}
+
+/* Returns a copy of the first count cells of the list in front of rest, which gains a reference. */
+static PList* copy_prefix(PList *list, int count, PList *rest) {
+    PList *result = plist_retain(rest);
+    PList **link = &result;
+    int size = count + plist_get_size(rest);
+    for (int i = 0; i < count; i++, list = list->next) {
+        PList *cell = (PList*) malloc(sizeof(PList));
+        cell->value = list->value;
+        cell->refs = 1;
+        cell->size = size - i;
+        *link = cell;
+        link = &cell->next;
+    }
+    *link = rest;
+    return result;
+}
+
+/* Returns the cell at the position, without a new reference. */
+static PList* cell_at(PList *list, int pos) {
+    for (int i = 0; list && i < pos; i++) {
+        list = list->next;
+    }
+    return list;
+}
+
+PList* plist_retain(PList *list) {
+    if (list) {
+        list->refs++;
+    }
+    return list;
+}
+
+void plist_release(PList **list) {
+    PList *cur = *list;
+    while (cur && --cur->refs == 0) {
+        PList *next = cur->next;
+        free(cur);
+        cur = next;
+    }
+    *list = NULL;
+}
+
+int plist_is_empty(PList *list) {
+    return list == NULL;
+}
+
+int plist_is_not_empty(PList *list) {
+    return list != NULL;
+}
+
+int plist_get_size(PList *list) {
+    return list ? list->size : 0;
+}
+
+PList* plist_cons(int value, PList *list) {
+    return new_cell(value, plist_retain(list));
+}
+
+PList* plist_from_array(int count, int *arr) {
+    PList *result = NULL;
+    for (int i = count - 1; i >= 0; i--) {
+        result = new_cell(arr[i], result);
+    }
+    return result;
+}
+
+PList* plist_from_ilist(IList *list) {
+    int *arr = to_array(list);
+    PList *result = plist_from_array(list->size, arr);
+    free(arr);
+    return result;
+}
+
+IList* plist_to_ilist(PList *list) {
+    IList *result = empty_list();
+    for (PList *cur = list; cur; cur = cur->next) {
+        push_back(result, cur->value);
+    }
+    return result;
+}
+
+int plist_get_first(PList *list) {
+    return list->value;
+}
+
+int plist_get(PList *list, int index) {
+    return cell_at(list, index)->value;
+}
+
+PList* plist_tail(PList *list) {
+    return list ? plist_retain(list->next) : NULL;
+}
+
+PList* plist_drop_n(PList *list, int n) {
+    return plist_retain(cell_at(list, n));
+}
+
+PList* plist_take(PList *list, int n) {
+    if (n >= plist_get_size(list)) {
+        return plist_retain(list);
+    }
+    return copy_prefix(list, n < 0 ? 0 : n, NULL);
+}
+
+PList* plist_update(PList *list, int pos, int value) {
+    PList *cell = cell_at(list, pos);
+    PList *rest = new_cell(value, plist_retain(cell->next));
+    PList *result = copy_prefix(list, pos, rest);
+    plist_release(&rest);
+    return result;
+}
+
+PList* plist_insert(PList *list, int pos, int value) {
+    PList *rest = new_cell(value, plist_retain(cell_at(list, pos)));
+    PList *result = copy_prefix(list, pos, rest);
+    plist_release(&rest);
+    return result;
+}
+
+PList* plist_delete(PList *list, int pos) {
+    return copy_prefix(list, pos, cell_at(list, pos)->next);
+}
+
+PList* plist_concat(PList *list, PList *other) {
+    if (!other) {
+        return plist_retain(list);
+    }
+    return copy_prefix(list, plist_get_size(list), other);
+}
+
+PList* plist_reverse(PList *list) {
+    PList *result = NULL;
+    for (PList *cur = list; cur; cur = cur->next) {
+        result = new_cell(cur->value, result);
+    }
+    return result;
+}
+
+static PList* map_with(PList *list, const Callback *op) {
+    int size = plist_get_size(list);
+    int *values = (int*) malloc((size ? size : 1) * sizeof(int));
+    int i = 0;
+    for (PList *cur = list; cur; cur = cur->next) {
+        values[i++] = apply(op, cur->value);
+    }
+    PList *result = plist_from_array(size, values);
+    free(values);
+    return result;
+}
+
+PList* plist_map(PList *list, i_func op) {
+    return map_with(list, PLAIN(op));
+}
+
+PList* plist_map_ctx(PList *list, i_func_ctx op, void *ctx) {
+    return map_with(list, WITH_CTX(op, ctx));
+}
+
+static PList* filter_where(PList *list, const Callback *pred) {
+    /* each run of kept cells is copied when a rejected element ends it, so the
+        predicate is called once per element; the run after the last rejected
+        element is kept as it is */
+    PList *result = NULL;
+    PList **link = &result;
+    PList *run = list;
+    int copied = 0;
+    for (PList *cur = list; cur; cur = cur->next) {
+        if (!apply(pred, cur->value)) {
+            for (; run != cur; run = run->next) {
+                PList *cell = (PList*) malloc(sizeof(PList));
+                cell->value = run->value;
+                cell->refs = 1;
+                *link = cell;
+                link = &cell->next;
+                copied++;
+            }
+            run = cur->next;
+        }
+    }
+    if (run == list) {
+        return plist_retain(list);
+    }
+    *link = plist_retain(run);
+    int size = copied + plist_get_size(run);
+    for (PList *cell = result; cell != run; cell = cell->next) {
+        cell->size = size--;
+    }
+    return result;
+}
+
+PList* plist_filter(PList *list, i_func pred) {
+    return filter_where(list, PLAIN(pred));
+}
+
+PList* plist_filter_ctx(PList *list, i_func_ctx pred, void *ctx) {
+    return filter_where(list, WITH_CTX(pred, ctx));
+}
+
+static int fold_with(int init, PList *list, const BiCallback *op) {
+    int acc = init;
+    for (PList *cur = list; cur; cur = cur->next) {
+        acc = combine(op, acc, cur->value);
+    }
+    return acc;
+}
+
+int plist_fold_left(int init, PList *list, i_bifunc op) {
+    return fold_with(init, list, PLAIN2(op));
+}
+
+int plist_fold_left_ctx(int init, PList *list, i_bifunc_ctx op, void *ctx) {
+    return fold_with(init, list, WITH_CTX2(op, ctx));
+}
+
+void plist_foreach(PList *list, void (*op)(int)) {
+    for (PList *cur = list; cur; cur = cur->next) {
+        op(cur->value);
+    }
+}
+
+void plist_foreach_ctx(PList *list, void (*op)(int, void*), void *ctx) {
+    for (PList *cur = list; cur; cur = cur->next) {
+        op(cur->value, ctx);
+    }
+}
+
+int plist_sum(PList *list) {
+    unsigned sum = 0;
+    for (PList *cur = list; cur; cur = cur->next) {
+        sum += (unsigned) cur->value;
+    }
+    return (int) sum;
+}
+
+int plist_contains(PList *list, int value) {
+    for (PList *cur = list; cur; cur = cur->next) {
+        if (cur->value == value) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+int plist_equals(PList *fst, PList *snd) {
+    if (plist_get_size(fst) != plist_get_size(snd)) {
+        return 0;
+    }
+    /* from a shared cell on, the lists are the same */
+    for (; fst != snd; fst = fst->next, snd = snd->next) {
+        if (fst->value != snd->value) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+int plist_is_suffix(PList *list, PList *suffix) {
+    int skip = plist_get_size(list) - plist_get_size(suffix);
+    return skip >= 0 && plist_equals(cell_at(list, skip), suffix);
+}
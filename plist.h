@@ -0,0 +1,126 @@
+#ifndef PLIST_H_
+#define PLIST_H_
+
+#include "ilist.h"
+
+/* Persistent Integer List
+
+    An immutable cons list. A list is a pointer to its first cell, and NULL
+    is the empty list. Cells are never changed once built, so lists share
+    their tails: plist_cons, plist_tail and plist_drop_n take no copy, and a
+    new version built by plist_update, plist_insert or plist_delete copies
+    only the cells in front of the change. Holding many versions of a long
+    list costs memory proportional to their differences.
+
+    Cells are reference counted. Every function that returns a list returns
+    a new reference, which the caller releases with plist_release; the
+    arguments are never consumed. Reference counts are not atomic: a list
+    may be read by several threads, but retained and released by one. */
+
+typedef struct PList {
+    int value;
+    int refs;
+    int size;
+    struct PList *next;
+} PList;
+
+/* Returns a new reference to the list. */
+extern PList* plist_retain(PList*);
+
+/* Releases the reference and frees the cells no other list uses. */
+extern void plist_release(PList**);
+
+/* Returns true if this list contains no elements. */
+extern int plist_is_empty(PList*);
+
+/* Returns true if this list contains some elements. */
+extern int plist_is_not_empty(PList*);
+
+/* Returns the number of elements in the list, in O(1). */
+extern int plist_get_size(PList*);
+
+/* Returns a list of the value followed by the elements of the list, in O(1). */
+extern PList* plist_cons(int, PList*);
+
+/* Returns a list of the specified count of elements from the array. */
+extern PList* plist_from_array(int, int*);
+
+/* Returns a list of the elements of the IList. */
+extern PList* plist_from_ilist(IList*);
+
+/* Returns an IList of the elements of the list. */
+extern IList* plist_to_ilist(PList*);
+
+/* Returns the first element of a non-empty list. */
+extern int plist_get_first(PList*);
+
+/* Returns the element at the specified index. */
+extern int plist_get(PList*, int);
+
+/* Returns the list without its first element, in O(1). */
+extern PList* plist_tail(PList*);
+
+/* Returns the list without its first n elements, sharing the rest. */
+extern PList* plist_drop_n(PList*, int);
+
+/* Returns the first n elements of the list. */
+extern PList* plist_take(PList*, int);
+
+/* Returns a version of the list with the element at the position replaced.
+    Copies the cells before the position and shares the rest. */
+extern PList* plist_update(PList*, int, int);
+
+/* Returns a version of the list with the value inserted at the position.
+    Copies the cells before the position and shares the rest. */
+extern PList* plist_insert(PList*, int, int);
+
+/* Returns a version of the list without the element at the position.
+    Copies the cells before the position and shares the rest. */
+extern PList* plist_delete(PList*, int);
+
+/* Returns the elements of the first list followed by the second one,
+    which is shared. */
+extern PList* plist_concat(PList*, PList*);
+
+/* Returns the list in reverse order. */
+extern PList* plist_reverse(PList*);
+
+/* Returns a list of the results of the function applied to the elements. */
+extern PList* plist_map(PList*, i_func);
+
+/* plist_map with a function that receives the context. */
+extern PList* plist_map_ctx(PList*, i_func_ctx, void*);
+
+/* Returns a list of the elements that match the predicate, which is called once
+    per element. The longest suffix whose elements all match is shared instead of copied. */
+extern PList* plist_filter(PList*, i_func);
+
+/* plist_filter with a predicate that receives the context. */
+extern PList* plist_filter_ctx(PList*, i_func_ctx, void*);
+
+/* Applies a binary operator to a start value and all elements of the list, going left to right. */
+extern int plist_fold_left(int, PList*, i_bifunc);
+
+/* plist_fold_left with an operator that receives the context. */
+extern int plist_fold_left_ctx(int, PList*, i_bifunc_ctx, void*);
+
+/* Performs the given action for each element of the list. */
+extern void plist_foreach(PList*, void (*op)(int));
+
+/* plist_foreach with an action that receives the context. */
+extern void plist_foreach_ctx(PList*, void (*op)(int, void*), void*);
+
+/* Sums up the elements of the list. */
+extern int plist_sum(PList*);
+
+/* Returns true if the list contains the specified element. */
+extern int plist_contains(PList*, int);
+
+/* Returns true if both lists have the same elements in the same order.
+    Stops comparing at the first shared cell. */
+extern int plist_equals(PList*, PList*);
+
+/* Returns true if the second list is a suffix of the first one. */
+extern int plist_is_suffix(PList*, PList*);
+
+#endif
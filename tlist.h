@@ -0,0 +1,264 @@
+#ifndef TLIST_H_
+#define TLIST_H_
+
+#include <stdlib.h>
+#include <stdint.h>
+
+/* Typed Linked Lists
+
+    DEFINE_LIST(name, T, U) generates a singly linked list of T named name,
+    with the core of the IList API as static inline functions prefixed
+    with name_ (name_push_back, name_map, name_sum, ...). Each element
+    type gets its own loops, which the compiler can inline and vectorize
+    for that type. Nodes are allocated with malloc, one per element.
+
+    U is the type name_sum accumulates in: the unsigned counterpart of an
+    integer T, so that a sum that overflows wraps around like the sum of
+    an IList, or T itself for a floating-point T.
+
+    Lists of int64_t, float and double are defined below as i64list,
+    f32list and f64list. */
+
+#define DEFINE_LIST(name, T, U) \
+ \
+typedef struct name##_node { \
+    T value; \
+    struct name##_node *next; \
+} name##_node; \
+ \
+typedef struct { \
+    name##_node *first; \
+    name##_node *last; \
+    int size; \
+} name; \
+ \
+/* Returns a empty list. */ \
+static inline name* name##_empty_list(void) { \
+    return (name*) calloc(1, sizeof(name)); \
+} \
+ \
+/* Delete the list and all of its elements. */ \
+static inline void name##_delete_list(name **list) { \
+    name##_node *cur = (*list)->first; \
+    while (cur) { \
+        name##_node *next = cur->next; \
+        free(cur); \
+        cur = next; \
+    } \
+    free(*list); \
+    *list = NULL; \
+} \
+ \
+static inline int name##_is_empty(name *list) { \
+    return list->size == 0; \
+} \
+ \
+static inline int name##_is_not_empty(name *list) { \
+    return list->size != 0; \
+} \
+ \
+static inline int name##_get_size(name *list) { \
+    return list->size; \
+} \
+ \
+/* [Mutator] Adds the value to the beginning of the list. */ \
+static inline name* name##_push(name *list, T value) { \
+    name##_node *node = (name##_node*) malloc(sizeof(name##_node)); \
+    node->value = value; \
+    node->next = list->first; \
+    list->first = node; \
+    if (!list->last) { \
+        list->last = node; \
+    } \
+    list->size++; \
+    return list; \
+} \
+ \
+/* [Mutator] Adds the value to the end of the list. */ \
+static inline name* name##_push_back(name *list, T value) { \
+    name##_node *node = (name##_node*) malloc(sizeof(name##_node)); \
+    node->value = value; \
+    node->next = NULL; \
+    if (list->last) { \
+        list->last->next = node; \
+    } else { \
+        list->first = node; \
+    } \
+    list->last = node; \
+    list->size++; \
+    return list; \
+} \
+ \
+/* [Mutator] Removes the first element of a non-empty list and returns it. */ \
+static inline T name##_pop(name *list) { \
+    name##_node *node = list->first; \
+    T value = node->value; \
+    list->first = node->next; \
+    if (!list->first) { \
+        list->last = NULL; \
+    } \
+    list->size--; \
+    free(node); \
+    return value; \
+} \
+ \
+static inline T name##_get_first(name *list) { \
+    return list->first->value; \
+} \
+ \
+static inline T name##_get_last(name *list) { \
+    return list->last->value; \
+} \
+ \
+/* Returns the element at the index, which must be in range. */ \
+static inline T name##_get(name *list, int index) { \
+    name##_node *cur = list->first; \
+    for (int i = 0; i < index; i++) { \
+        cur = cur->next; \
+    } \
+    return cur->value; \
+} \
+ \
+/* Returns a list of the first count elements of the array. */ \
+static inline name* name##_from_array(int count, const T *arr) { \
+    name *list = name##_empty_list(); \
+    for (int i = 0; i < count; i++) { \
+        name##_push_back(list, arr[i]); \
+    } \
+    return list; \
+} \
+ \
+/* Returns a new array of the elements of the list. */ \
+static inline T* name##_to_array(name *list) { \
+    T *arr = (T*) malloc((list->size ? list->size : 1) * sizeof(T)); \
+    int i = 0; \
+    for (name##_node *cur = list->first; cur; cur = cur->next) { \
+        arr[i++] = cur->value; \
+    } \
+    return arr; \
+} \
+ \
+static inline void name##_foreach(name *list, void (*op)(T)) { \
+    for (name##_node *cur = list->first; cur; cur = cur->next) { \
+        op(cur->value); \
+    } \
+} \
+ \
+/* [Mutator] Applies the function to the elements of the list. */ \
+static inline name* name##_map(name *list, T (*op)(T)) { \
+    for (name##_node *cur = list->first; cur; cur = cur->next) { \
+        cur->value = op(cur->value); \
+    } \
+    return list; \
+} \
+ \
+/* Returns a new list of the elements that match the predicate. */ \
+static inline name* name##_filter(name *list, int (*pred)(T)) { \
+    name *result = name##_empty_list(); \
+    for (name##_node *cur = list->first; cur; cur = cur->next) { \
+        if (pred(cur->value)) { \
+            name##_push_back(result, cur->value); \
+        } \
+    } \
+    return result; \
+} \
+ \
+static inline T name##_fold_left(T init, name *list, T (*op)(T, T)) { \
+    T acc = init; \
+    for (name##_node *cur = list->first; cur; cur = cur->next) { \
+        acc = op(acc, cur->value); \
+    } \
+    return acc; \
+} \
+ \
+static inline int name##_count(name *list, int (*pred)(T)) { \
+    int count = 0; \
+    for (name##_node *cur = list->first; cur; cur = cur->next) { \
+        if (pred(cur->value)) { \
+            count++; \
+        } \
+    } \
+    return count; \
+} \
+ \
+static inline int name##_forall(name *list, int (*pred)(T)) { \
+    for (name##_node *cur = list->first; cur; cur = cur->next) { \
+        if (!pred(cur->value)) { \
+            return 0; \
+        } \
+    } \
+    return 1; \
+} \
+ \
+static inline int name##_exists(name *list, int (*pred)(T)) { \
+    for (name##_node *cur = list->first; cur; cur = cur->next) { \
+        if (pred(cur->value)) { \
+            return 1; \
+        } \
+    } \
+    return 0; \
+} \
+ \
+static inline int name##_contains(name *list, T value) { \
+    for (name##_node *cur = list->first; cur; cur = cur->next) { \
+        if (cur->value == value) { \
+            return 1; \
+        } \
+    } \
+    return 0; \
+} \
+ \
+static inline int name##_index_of(name *list, T value) { \
+    int index = 0; \
+    for (name##_node *cur = list->first; cur; cur = cur->next, index++) { \
+        if (cur->value == value) { \
+            return index; \
+        } \
+    } \
+    return -1; \
+} \
+ \
+static inline T name##_sum(name *list) { \
+    U sum = 0; \
+    for (name##_node *cur = list->first; cur; cur = cur->next) { \
+        sum += (U) cur->value; \
+    } \
+    return (T) sum; \
+} \
+ \
+/* Returns the largest element of a non-empty list. */ \
+static inline T name##_max(name *list) { \
+    T max = list->first->value; \
+    for (name##_node *cur = list->first->next; cur; cur = cur->next) { \
+        if (cur->value > max) { \
+            max = cur->value; \
+        } \
+    } \
+    return max; \
+} \
+ \
+/* Returns the smallest element of a non-empty list. */ \
+static inline T name##_min(name *list) { \
+    T min = list->first->value; \
+    for (name##_node *cur = list->first->next; cur; cur = cur->next) { \
+        if (cur->value < min) { \
+            min = cur->value; \
+        } \
+    } \
+    return min; \
+} \
+ \
+/* Returns a new list with the elements in reverse order. */ \
+static inline name* name##_reverse(name *list) { \
+    name *result = name##_empty_list(); \
+    for (name##_node *cur = list->first; cur; cur = cur->next) { \
+        name##_push(result, cur->value); \
+    } \
+    return result; \
+}
+
+DEFINE_LIST(i64list, int64_t, uint64_t)
+DEFINE_LIST(f32list, float, float)
+DEFINE_LIST(f64list, double, double)
+
+#endif
@@ -0,0 +1,1058 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include <string.h>
+#include "ulist.h"
+#include "ireduce.h"
+#include "iset.h"
+#include "icallback.h"
+
+static Chunk* new_chunk() {
+    Chunk *chunk = (Chunk*) malloc(sizeof(Chunk));
+    chunk->next = NULL;
+    chunk->count = 0;
+    return chunk;
+}
+
+/* Returns the chunk holding the element at the index, its offset in the chunk
+    and the previous chunk (or NULL). */
+static Chunk* find_chunk(UList *list, int index, int *offset, Chunk **prev) {
+    Chunk *before = NULL;
+    Chunk *cur = list->first;
+    if (index >= list->size - list->last->count) {
+        cur = list->last;
+        index -= list->size - list->last->count;
+        if (prev && cur != list->first) {
+            for (before = list->first; before->next != cur; before = before->next);
+        }
+    } else {
+        while (index >= cur->count) {
+            index -= cur->count;
+            before = cur;
+            cur = cur->next;
+        }
+    }
+    *offset = index;
+    if (prev) {
+        *prev = before;
+    }
+    return cur;
+}
+
+static void unlink_chunk(UList *list, Chunk *prev, Chunk *chunk) {
+    if (prev) {
+        prev->next = chunk->next;
+    } else {
+        list->first = chunk->next;
+    }
+    if (list->last == chunk) {
+        list->last = prev;
+    }
+    free(chunk);
+}
+
+static void clear_chunks(UList *list) {
+    Chunk *chunk = list->first;
+    while (chunk) {
+        Chunk *next = chunk->next;
+        free(chunk);
+        chunk = next;
+    }
+    list->first = NULL;
+    list->last = NULL;
+    list->size = 0;
+}
+
+/* Keeps first n elements of the list. */
+static void truncate_to(UList *list, int n) {
+    if (n >= list->size) {
+        return;
+    }
+    if (n <= 0) {
+        clear_chunks(list);
+        return;
+    }
+    int offset;
+    Chunk *chunk = find_chunk(list, n - 1, &offset, NULL);
+    chunk->count = offset + 1;
+    Chunk *rest = chunk->next;
+    while (rest) {
+        Chunk *next = rest->next;
+        free(rest);
+        rest = next;
+    }
+    chunk->next = NULL;
+    list->last = chunk;
+    list->size = n;
+}
+
+/* Removes first n elements of the list. */
+static void drop_front(UList *list, int n) {
+    if (n >= list->size) {
+        clear_chunks(list);
+        return;
+    }
+    list->size -= n;
+    while (n >= list->first->count) {
+        Chunk *chunk = list->first;
+        n -= chunk->count;
+        list->first = chunk->next;
+        free(chunk);
+    }
+    if (n > 0) {
+        Chunk *chunk = list->first;
+        chunk->count -= n;
+        memmove(chunk->values, chunk->values + n, chunk->count * sizeof(int));
+    }
+}
+
+/* Returns an array of chunk pointers to traverse the list from right to left. */
+static Chunk** chunk_stack(UList *list, int *n) {
+    int count = 0;
+    for (Chunk *c = list->first; c; c = c->next) {
+        count++;
+    }
+    Chunk **stack = (Chunk**) malloc((count > 0 ? count : 1) * sizeof(Chunk*));
+    count = 0;
+    for (Chunk *c = list->first; c; c = c->next) {
+        stack[count++] = c;
+    }
+    *n = count;
+    return stack;
+}
+
+/* Applies a binary operator to first n elements and a start value, going right to left. */
+static int fold_right_n(int init, UList *list, int n, const BiCallback *op) {
+    int depth;
+    Chunk **stack = chunk_stack(list, &depth);
+    int acc = init;
+    int skip = list->size - n;
+    for (int c = depth - 1; c >= 0; c--) {
+        int i = stack[c]->count - 1;
+        for (; skip > 0 && i >= 0; i--, skip--);
+        for (; i >= 0; i--) {
+            acc = combine(op, stack[c]->values[i], acc);
+        }
+    }
+    free(stack);
+    return acc;
+}
+
+int ulist_is_empty(UList *list) {
+    return list->size == 0;
+}
+
+int ulist_is_not_empty(UList *list) {
+    return list->size != 0;
+}
+
+UList* ulist_empty_list() {
+    UList *list = (UList*) malloc(sizeof(UList));
+    list->first = NULL;
+    list->last = NULL;
+    list->size = 0;
+    return list;
+}
+
+UList* ulist_single_list_of(int value) {
+    return ulist_push_back(ulist_empty_list(), value);
+}
+
+UList* ulist_list_of(int count, ...) {
+    va_list items;
+    va_start(items, count);
+    UList *list = ulist_empty_list();
+    for (int i = 0; i < count; i++) {
+        ulist_push_back(list, va_arg(items, int));
+    }
+    va_end(items);
+    return list;
+}
+
+UList* ulist_range(int first, int last) {
+    return ulist_range_step(first, last, first < last ? 1 : -1);
+}
+
+UList* ulist_range_step(int first, int last, int step) {
+    UList *list = ulist_empty_list();
+    if (step > 0) {
+        for (int i = first; i <= last; i += step) {
+            ulist_push_back(list, i);
+        }
+    } else {
+        for (int i = first; i >= last; i += step) {
+            ulist_push_back(list, i);
+        }
+    }
+    return list;
+}
+
+UList* ulist_range_ex(int first, int last) {
+    return ulist_range_step_ex(first, last, first < last ? 1 : -1);
+}
+
+UList* ulist_range_step_ex(int first, int last, int step) {
+    UList *list = ulist_empty_list();
+    if (step > 0) {
+        for (int i = first; i < last; i += step) {
+            ulist_push_back(list, i);
+        }
+    } else {
+        for (int i = first; i > last; i += step) {
+            ulist_push_back(list, i);
+        }
+    }
+    return list;
+}
+
+static UList* generate_count(int start, const Callback *op, int count) {
+    UList *list = ulist_empty_list();
+    for (int cur = start, i = 0; i < count; cur = apply(op, cur), i++) {
+        ulist_push_back(list, cur);
+    }
+    return list;
+}
+
+UList* ulist_generate_n(int start, i_func op, int count) {
+    return generate_count(start, PLAIN(op), count);
+}
+
+UList* ulist_generate_n_ctx(int start, i_func_ctx op, int count, void *ctx) {
+    return generate_count(start, WITH_CTX(op, ctx), count);
+}
+
+static UList* generate_until(int start, const Callback *op, const Callback *cond) {
+    UList *list = ulist_empty_list();
+    for (int cur = start; apply(cond, cur); cur = apply(op, cur)) {
+        ulist_push_back(list, cur);
+    }
+    return list;
+}
+
+UList* ulist_generate_while(int start, i_func op, i_func cond) {
+    return generate_until(start, PLAIN(op), PLAIN(cond));
+}
+
+UList* ulist_generate_while_ctx(int start, i_func_ctx op, i_func_ctx cond, void *ctx) {
+    return generate_until(start, WITH_CTX(op, ctx), WITH_CTX(cond, ctx));
+}
+
+UList* ulist_repeat(int value, int count) {
+    UList *list = ulist_empty_list();
+    for (int i = 0; i < count; i++) {
+        ulist_push_back(list, value);
+    }
+    return list;
+}
+
+void ulist_delete_list(UList **list) {
+    clear_chunks(*list);
+    free(*list);
+    *list = NULL;
+}
+
+int ulist_equals(UList *fst, UList *snd) {
+    if (fst->size != snd->size) {
+        return 0;
+    }
+    Chunk *c1 = fst->first, *c2 = snd->first;
+    for (int i = 0, j = 0; c1 && c2;) {
+        if (c1->values[i] != c2->values[j]) {
+            return 0;
+        }
+        if (++i == c1->count) {
+            c1 = c1->next;
+            i = 0;
+        }
+        if (++j == c2->count) {
+            c2 = c2->next;
+            j = 0;
+        }
+    }
+    return 1;
+}
+
+int ulist_get_size(UList *list) {
+    return list->size;
+}
+
+UList* ulist_push(UList *list, int value) {
+    Chunk *chunk = list->first;
+    if (!chunk || chunk->count == ULIST_CHUNK) {
+        chunk = new_chunk();
+        chunk->next = list->first;
+        list->first = chunk;
+        if (!list->last) {
+            list->last = chunk;
+        }
+    }
+    memmove(chunk->values + 1, chunk->values, chunk->count * sizeof(int));
+    chunk->values[0] = value;
+    chunk->count++;
+    list->size++;
+    return list;
+}
+
+UList* ulist_push_back(UList *list, int value) {
+    Chunk *chunk = list->last;
+    if (!chunk || chunk->count == ULIST_CHUNK) {
+        chunk = new_chunk();
+        if (list->last) {
+            list->last->next = chunk;
+        } else {
+            list->first = chunk;
+        }
+        list->last = chunk;
+    }
+    chunk->values[chunk->count++] = value;
+    list->size++;
+    return list;
+}
+
+UList* ulist_insert(UList *list, int pos, int value) {
+    if (pos == 0) {
+        return ulist_push(list, value);
+    } else if (pos == list->size) {
+        return ulist_push_back(list, value);
+    }
+    int offset;
+    Chunk *chunk = find_chunk(list, pos, &offset, NULL);
+    if (chunk->count == ULIST_CHUNK) {
+        Chunk *half = new_chunk();
+        half->count = ULIST_CHUNK / 2;
+        chunk->count -= half->count;
+        memcpy(half->values, chunk->values + chunk->count, half->count * sizeof(int));
+        half->next = chunk->next;
+        chunk->next = half;
+        if (list->last == chunk) {
+            list->last = half;
+        }
+        if (offset > chunk->count) {
+            offset -= chunk->count;
+            chunk = half;
+        }
+    }
+    memmove(chunk->values + offset + 1, chunk->values + offset, (chunk->count - offset) * sizeof(int));
+    chunk->values[offset] = value;
+    chunk->count++;
+    list->size++;
+    return list;
+}
+
+int ulist_pop(UList *list) {
+    int value = ulist_get_first(list);
+    ulist_drop(list);
+    return value;
+}
+
+int ulist_pop_back(UList *list) {
+    int value = ulist_get_last(list);
+    ulist_drop_back(list);
+    return value;
+}
+
+UList* ulist_delete(UList *list, int pos) {
+    int offset;
+    Chunk *prev;
+    Chunk *chunk = find_chunk(list, pos, &offset, &prev);
+    chunk->count--;
+    memmove(chunk->values + offset, chunk->values + offset + 1, (chunk->count - offset) * sizeof(int));
+    list->size--;
+    if (chunk->count == 0) {
+        unlink_chunk(list, prev, chunk);
+    } else if (chunk->count < ULIST_CHUNK / 2 && chunk->next
+            && chunk->count + chunk->next->count <= ULIST_CHUNK) {
+        Chunk *next = chunk->next;
+        memcpy(chunk->values + chunk->count, next->values, next->count * sizeof(int));
+        chunk->count += next->count;
+        unlink_chunk(list, chunk, next);
+    }
+    return list;
+}
+
+UList* ulist_delete_item(UList *list, int value) {
+    int size = 0;
+    Chunk *dst = list->first;
+    int d = 0;
+    for (Chunk *c = list->first; c; c = c->next) {
+        for (int i = 0; i < c->count; i++) {
+            if (c->values[i] != value) {
+                if (d == dst->count) {
+                    dst = dst->next;
+                    d = 0;
+                }
+                dst->values[d++] = c->values[i];
+                size++;
+            }
+        }
+    }
+    truncate_to(list, size);
+    return list;
+}
+
+UList* ulist_drop(UList *list) {
+    drop_front(list, 1);
+    return list;
+}
+
+UList* ulist_drop_back(UList *list) {
+    truncate_to(list, list->size - 1);
+    return list;
+}
+
+UList* ulist_drop_n(UList *list, int n) {
+    drop_front(list, n);
+    return list;
+}
+
+UList* ulist_drop_back_n(UList *list, int n) {
+    truncate_to(list, list->size - n);
+    return list;
+}
+
+static UList* drop_front_where(UList *list, const Callback *pred) {
+    int n = 0;
+    for (Chunk *c = list->first; c; c = c->next) {
+        for (int i = 0; i < c->count; i++, n++) {
+            if (!apply(pred, c->values[i])) {
+                drop_front(list, n);
+                return list;
+            }
+        }
+    }
+    drop_front(list, n);
+    return list;
+}
+
+UList* ulist_drop_while(UList *list, i_func pred) {
+    return drop_front_where(list, PLAIN(pred));
+}
+
+UList* ulist_drop_while_ctx(UList *list, i_func_ctx pred, void *ctx) {
+    return drop_front_where(list, WITH_CTX(pred, ctx));
+}
+
+static UList* drop_back_where(UList *list, const Callback *pred) {
+    int keep = 0;
+    int index = 0;
+    for (Chunk *c = list->first; c; c = c->next) {
+        for (int i = 0; i < c->count; i++) {
+            index++;
+            if (!apply(pred, c->values[i])) {
+                keep = index;
+            }
+        }
+    }
+    truncate_to(list, keep);
+    return list;
+}
+
+UList* ulist_drop_back_while(UList *list, i_func pred) {
+    return drop_back_where(list, PLAIN(pred));
+}
+
+UList* ulist_drop_back_while_ctx(UList *list, i_func_ctx pred, void *ctx) {
+    return drop_back_where(list, WITH_CTX(pred, ctx));
+}
+
+UList* ulist_update(UList *list, int pos, int value) {
+    int offset;
+    Chunk *chunk = find_chunk(list, pos, &offset, NULL);
+    chunk->values[offset] = value;
+    return list;
+}
+
+UList* ulist_sublist(UList *list, int start, int end) {
+    truncate_to(list, end);
+    drop_front(list, start);
+    return list;
+}
+
+UList* ulist_from_array(int size, int *arr) {
+    UList *result = ulist_empty_list();
+    if (arr == NULL) {
+        return result;
+    }
+    return ulist_append_array(result, size, arr);
+}
+
+int* ulist_to_array(UList *list) {
+    int ind = 0;
+    int *arr = (int*) malloc(list->size * sizeof(int));
+    for (Chunk *c = list->first; c; c = c->next) {
+        memcpy(arr + ind, c->values, c->count * sizeof(int));
+        ind += c->count;
+    }
+    return arr;
+}
+
+int ulist_to_array_into(UList *list, int *buf, int cap) {
+    int ind = 0;
+    for (Chunk *c = list->first; c && ind < cap; c = c->next) {
+        int n = c->count < cap - ind ? c->count : cap - ind;
+        memcpy(buf + ind, c->values, n * sizeof(int));
+        ind += n;
+    }
+    return ind;
+}
+
+UList* ulist_append_array(UList *list, int size, int *arr) {
+    while (size > 0) {
+        Chunk *chunk = list->last;
+        if (!chunk || chunk->count == ULIST_CHUNK) {
+            chunk = new_chunk();
+            if (list->last) {
+                list->last->next = chunk;
+            } else {
+                list->first = chunk;
+            }
+            list->last = chunk;
+        }
+        int n = ULIST_CHUNK - chunk->count;
+        if (n > size) {
+            n = size;
+        }
+        memcpy(chunk->values + chunk->count, arr, n * sizeof(int));
+        chunk->count += n;
+        list->size += n;
+        arr += n;
+        size -= n;
+    }
+    return list;
+}
+
+UListBlocks ulist_blocks(UList *list) {
+    return (UListBlocks) { list->first };
+}
+
+int ulist_next_block(UListBlocks *blocks, int **values) {
+    Chunk *chunk = blocks->chunk;
+    if (!chunk) {
+        return 0;
+    }
+    blocks->chunk = chunk->next;
+    *values = chunk->values;
+    return chunk->count;
+}
+
+void ulist_foreach(UList *list, void (*op)(int)) {
+    for (Chunk *c = list->first; c; c = c->next) {
+        for (int i = 0; i < c->count; i++) {
+            op(c->values[i]);
+        }
+    }
+}
+
+void ulist_foreach_ctx(UList *list, void (*op)(int, void*), void *ctx) {
+    for (Chunk *c = list->first; c; c = c->next) {
+        for (int i = 0; i < c->count; i++) {
+            op(c->values[i], ctx);
+        }
+    }
+}
+
+void ulist_print_list(UList *list) {
+    printf("UList %p : [", list);
+    for (Chunk *c = list->first; c; c = c->next) {
+        for (int i = 0; i < c->count; i++) {
+            printf(c == list->last && i == c->count - 1 ? "%d" : "%d, ", c->values[i]);
+        }
+    }
+    printf("]\n");
+}
+
+UList* ulist_reverse(UList *list) {
+    UList *result = ulist_empty_list();
+    int depth;
+    Chunk **stack = chunk_stack(list, &depth);
+    for (int c = depth - 1; c >= 0; c--) {
+        for (int i = stack[c]->count - 1; i >= 0; i--) {
+            ulist_push_back(result, stack[c]->values[i]);
+        }
+    }
+    free(stack);
+    return result;
+}
+
+int ulist_get_first(UList *list) {
+    return list->first->values[0];
+}
+
+int ulist_get_last(UList *list) {
+    return list->last->values[list->last->count - 1];
+}
+
+int ulist_get(UList *list, int index) {
+    int offset;
+    Chunk *chunk = find_chunk(list, index, &offset, NULL);
+    return chunk->values[offset];
+}
+
+int ulist_find(UList *list, i_func pred) {
+    return ulist_find_or(list, pred, 0);
+}
+
+int ulist_find_not(UList *list, i_func pred) {
+    return ulist_find_not_or(list, pred, 0);
+}
+
+int ulist_find_ctx(UList *list, i_func_ctx pred, void *ctx) {
+    return ulist_find_or_ctx(list, pred, 0, ctx);
+}
+
+int ulist_find_not_ctx(UList *list, i_func_ctx pred, void *ctx) {
+    return ulist_find_not_or_ctx(list, pred, 0, ctx);
+}
+
+/* Stores the first element for which the predicate is true (or false if wanted is)
+    and returns true, or returns false if there is none. */
+static int find_where(UList *list, const Callback *pred, int wanted, int *value) {
+    for (Chunk *c = list->first; c; c = c->next) {
+        for (int i = 0; i < c->count; i++) {
+            if (!apply(pred, c->values[i]) == !wanted) {
+                *value = c->values[i];
+                return 1;
+            }
+        }
+    }
+    return 0;
+}
+
+int ulist_find_or(UList *list, i_func pred, int default_value) {
+    int value;
+    return find_where(list, PLAIN(pred), 1, &value) ? value : default_value;
+}
+
+int ulist_find_not_or(UList *list, i_func pred, int default_value) {
+    int value;
+    return find_where(list, PLAIN(pred), 0, &value) ? value : default_value;
+}
+
+int ulist_find_or_ctx(UList *list, i_func_ctx pred, int default_value, void *ctx) {
+    int value;
+    return find_where(list, WITH_CTX(pred, ctx), 1, &value) ? value : default_value;
+}
+
+int ulist_find_not_or_ctx(UList *list, i_func_ctx pred, int default_value, void *ctx) {
+    int value;
+    return find_where(list, WITH_CTX(pred, ctx), 0, &value) ? value : default_value;
+}
+
+int ulist_index_of(UList *list, int item) {
+    int base = 0;
+    for (Chunk *c = list->first; c; base += c->count, c = c->next) {
+        int index = index_of_array(c->count, c->values, item);
+        if (index != -1) {
+            return base + index;
+        }
+    }
+    return -1;
+}
+
+int ulist_last_index_of(UList *list, int item) {
+    int index = -1;
+    int base = 0;
+    for (Chunk *c = list->first; c; base += c->count, c = c->next) {
+        int last = last_index_of_array(c->count, c->values, item);
+        if (last != -1) {
+            index = base + last;
+        }
+    }
+    return index;
+}
+
+UList* ulist_clone(UList *list) {
+    UList *result = ulist_empty_list();
+    for (Chunk *c = list->first; c; c = c->next) {
+        Chunk *copy = new_chunk();
+        copy->count = c->count;
+        memcpy(copy->values, c->values, c->count * sizeof(int));
+        if (result->last) {
+            result->last->next = copy;
+        } else {
+            result->first = copy;
+        }
+        result->last = copy;
+    }
+    result->size = list->size;
+    return result;
+}
+
+static UList* map_with(UList *list, const Callback *op) {
+    for (Chunk *c = list->first; c; c = c->next) {
+        for (int i = 0; i < c->count; i++) {
+            c->values[i] = apply(op, c->values[i]);
+        }
+    }
+    return list;
+}
+
+UList* ulist_map(UList *list, i_func op) {
+    return map_with(list, PLAIN(op));
+}
+
+UList* ulist_map_ctx(UList *list, i_func_ctx op, void *ctx) {
+    return map_with(list, WITH_CTX(op, ctx));
+}
+
+/* Returns a new list of the elements for which the predicate is true (or false if keep is). */
+static UList* filter_where(UList *list, const Callback *pred, int keep) {
+    UList *result = ulist_empty_list();
+    for (Chunk *c = list->first; c; c = c->next) {
+        for (int i = 0; i < c->count; i++) {
+            if (!apply(pred, c->values[i]) == !keep) {
+                ulist_push_back(result, c->values[i]);
+            }
+        }
+    }
+    return result;
+}
+
+UList* ulist_filter(UList *list, i_func pred) {
+    return filter_where(list, PLAIN(pred), 1);
+}
+
+UList* ulist_filter_not(UList *list, i_func pred) {
+    return filter_where(list, PLAIN(pred), 0);
+}
+
+UList* ulist_filter_ctx(UList *list, i_func_ctx pred, void *ctx) {
+    return filter_where(list, WITH_CTX(pred, ctx), 1);
+}
+
+UList* ulist_filter_not_ctx(UList *list, i_func_ctx pred, void *ctx) {
+    return filter_where(list, WITH_CTX(pred, ctx), 0);
+}
+
+UList* ulist_add_all(UList *list, UList *elems) {
+    int size = elems->size;
+    for (Chunk *c = elems->first; c && size > 0; c = c->next) {
+        for (int i = 0; i < c->count && size > 0; i++, size--) {
+            ulist_push_back(list, c->values[i]);
+        }
+    }
+    return list;
+}
+
+int ulist_contains(UList *list, int value) {
+    return ulist_index_of(list, value) != -1;
+}
+
+/* Applies the operator to the accumulator and each element after the first skip ones,
+    going left to right. */
+static int fold_from(int init, UList *list, int skip, const BiCallback *op) {
+    int acc = init;
+    for (Chunk *c = list->first; c; c = c->next) {
+        for (int i = c == list->first ? skip : 0; i < c->count; i++) {
+            acc = combine(op, acc, c->values[i]);
+        }
+    }
+    return acc;
+}
+
+static int reduce_from(UList *list, const BiCallback *op) {
+    return ulist_is_empty(list) ? 0 : fold_from(list->first->values[0], list, 1, op);
+}
+
+static int reduce_back(UList *list, const BiCallback *op) {
+    if (ulist_is_empty(list)) {
+        return 0;
+    }
+    return fold_right_n(ulist_get_last(list), list, list->size - 1, op);
+}
+
+int ulist_fold_left(int init, UList *list, i_bifunc op) {
+    return fold_from(init, list, 0, PLAIN2(op));
+}
+
+int ulist_reduce_left(UList *list, i_bifunc op) {
+    return reduce_from(list, PLAIN2(op));
+}
+
+int ulist_fold_right(int init, UList *list, i_bifunc op) {
+    return fold_right_n(init, list, list->size, PLAIN2(op));
+}
+
+int ulist_reduce_right(UList *list, i_bifunc op) {
+    return reduce_back(list, PLAIN2(op));
+}
+
+int ulist_fold_left_ctx(int init, UList *list, i_bifunc_ctx op, void *ctx) {
+    return fold_from(init, list, 0, WITH_CTX2(op, ctx));
+}
+
+int ulist_reduce_left_ctx(UList *list, i_bifunc_ctx op, void *ctx) {
+    return reduce_from(list, WITH_CTX2(op, ctx));
+}
+
+int ulist_fold_right_ctx(int init, UList *list, i_bifunc_ctx op, void *ctx) {
+    return fold_right_n(init, list, list->size, WITH_CTX2(op, ctx));
+}
+
+int ulist_reduce_right_ctx(UList *list, i_bifunc_ctx op, void *ctx) {
+    return reduce_back(list, WITH_CTX2(op, ctx));
+}
+
+UList* ulist_take(UList *list, int n) {
+    return ulist_slice(list, 0, n - 1);
+}
+
+static UList* take_where(UList *list, const Callback *pred) {
+    UList *result = ulist_empty_list();
+    for (Chunk *c = list->first; c; c = c->next) {
+        for (int i = 0; i < c->count; i++) {
+            if (!apply(pred, c->values[i])) {
+                return result;
+            }
+            ulist_push_back(result, c->values[i]);
+        }
+    }
+    return result;
+}
+
+UList* ulist_take_while(UList *list, i_func pred) {
+    return take_where(list, PLAIN(pred));
+}
+
+UList* ulist_take_while_ctx(UList *list, i_func_ctx pred, void *ctx) {
+    return take_where(list, WITH_CTX(pred, ctx));
+}
+
+UList* ulist_take_right(UList *list, int n) {
+    return ulist_slice(list, list->size - n, list->size - 1);
+}
+
+static UList* take_right_where(UList *list, const Callback *pred) {
+    int start = 0;
+    int index = 0;
+    for (Chunk *c = list->first; c; c = c->next) {
+        for (int i = 0; i < c->count; i++) {
+            index++;
+            if (!apply(pred, c->values[i])) {
+                start = index;
+            }
+        }
+    }
+    return ulist_slice(list, start, list->size - 1);
+}
+
+UList* ulist_take_right_while(UList *list, i_func pred) {
+    return take_right_where(list, PLAIN(pred));
+}
+
+UList* ulist_take_right_while_ctx(UList *list, i_func_ctx pred, void *ctx) {
+    return take_right_where(list, WITH_CTX(pred, ctx));
+}
+
+UList* ulist_slice(UList *list, int start, int end) {
+    UList *result = ulist_empty_list();
+    if (start < 0) {
+        start = 0;
+    }
+    if (end > list->size - 1) {
+        end = list->size - 1;
+    }
+    if (start > end) {
+        return result;
+    }
+    int offset;
+    Chunk *c = find_chunk(list, start, &offset, NULL);
+    for (int n = end - start + 1; n > 0; c = c->next, offset = 0) {
+        for (int i = offset; i < c->count && n > 0; i++, n--) {
+            ulist_push_back(result, c->values[i]);
+        }
+    }
+    return result;
+}
+
+static int count_where(UList *list, const Callback *pred) {
+    int count = 0;
+    for (Chunk *c = list->first; c; c = c->next) {
+        for (int i = 0; i < c->count; i++) {
+            if (apply(pred, c->values[i])) {
+                count++;
+            }
+        }
+    }
+    return count;
+}
+
+int ulist_forall(UList *list, i_func pred) {
+    int value;
+    return !find_where(list, PLAIN(pred), 0, &value);
+}
+
+int ulist_exists(UList *list, i_func pred) {
+    int value;
+    return find_where(list, PLAIN(pred), 1, &value);
+}
+
+int ulist_count(UList *list, i_func pred) {
+    return count_where(list, PLAIN(pred));
+}
+
+int ulist_forall_ctx(UList *list, i_func_ctx pred, void *ctx) {
+    int value;
+    return !find_where(list, WITH_CTX(pred, ctx), 0, &value);
+}
+
+int ulist_exists_ctx(UList *list, i_func_ctx pred, void *ctx) {
+    int value;
+    return find_where(list, WITH_CTX(pred, ctx), 1, &value);
+}
+
+int ulist_count_ctx(UList *list, i_func_ctx pred, void *ctx) {
+    return count_where(list, WITH_CTX(pred, ctx));
+}
+
+UList* ulist_unique(UList *list) {
+    UList *result = ulist_empty_list();
+    ISet *seen = iset_empty(list->size);
+    for (Chunk *c = list->first; c; c = c->next) {
+        for (int i = 0; i < c->count; i++) {
+            if (iset_add(seen, c->values[i])) {
+                ulist_push_back(result, c->values[i]);
+            }
+        }
+    }
+    iset_delete(&seen);
+    return result;
+}
+
+UList* ulist_distinct(UList *list) {
+    int size = 0;
+    Chunk *dst = list->first;
+    int d = 0;
+    ISet *seen = iset_empty(list->size);
+    for (Chunk *c = list->first; c; c = c->next) {
+        for (int i = 0; i < c->count; i++) {
+            int value = c->values[i];
+            if (iset_add(seen, value)) {
+                if (d == dst->count) {
+                    dst = dst->next;
+                    d = 0;
+                }
+                dst->values[d++] = value;
+                size++;
+            }
+        }
+    }
+    iset_delete(&seen);
+    truncate_to(list, size);
+    return list;
+}
+
+UList* ulist_swap(UList *list, int i, int j) {
+    int oi, oj;
+    Chunk *ci = find_chunk(list, i, &oi, NULL);
+    Chunk *cj = find_chunk(list, j, &oj, NULL);
+    int vi = ci->values[oi];
+    ci->values[oi] = cj->values[oj];
+    cj->values[oj] = vi;
+    return list;
+}
+
+/* Returns true iff the elements of the second list occur in the first one
+    starting at the chunk and offset. */
+static int matches_at(Chunk *c, int offset, UList *pattern) {
+    for (Chunk *p = pattern->first; p; p = p->next) {
+        for (int i = 0; i < p->count; i++) {
+            if (offset == c->count) {
+                c = c->next;
+                offset = 0;
+            }
+            if (!c || c->values[offset++] != p->values[i]) {
+                return 0;
+            }
+        }
+    }
+    return 1;
+}
+
+int ulist_is_prefix(UList *list, UList *prefix) {
+    if (ulist_is_empty(prefix)) {
+        return 1;
+    }
+    if (list->size < prefix->size) {
+        return 0;
+    }
+    return matches_at(list->first, 0, prefix);
+}
+
+int ulist_is_suffix(UList *list, UList *suffix) {
+    if (ulist_is_empty(suffix)) {
+        return 1;
+    }
+    if (list->size < suffix->size) {
+        return 0;
+    }
+    int offset;
+    Chunk *chunk = find_chunk(list, list->size - suffix->size, &offset, NULL);
+    return matches_at(chunk, offset, suffix);
+}
+
+int ulist_is_sublist(UList *list, UList *sublist) {
+    if (ulist_is_empty(sublist)) {
+        return 1;
+    }
+    int tries = list->size - sublist->size + 1;
+    for (Chunk *c = list->first; c && tries > 0; c = c->next) {
+        for (int i = 0; i < c->count && tries > 0; i++, tries--) {
+            if (matches_at(c, i, sublist)) {
+                return 1;
+            }
+        }
+    }
+    return 0;
+}
+
+UList* ulist_intersperse(UList *list, int value) {
+    UList *result = ulist_empty_list();
+    for (Chunk *c = list->first; c; c = c->next) {
+        for (int i = 0; i < c->count; i++) {
+            if (ulist_is_not_empty(result)) {
+                ulist_push_back(result, value);
+            }
+            ulist_push_back(result, c->values[i]);
+        }
+    }
+    return result;
+}
+
+int ulist_max(UList *list) {
+    int max = ulist_get_first(list);
+    for (Chunk *c = list->first; c; c = c->next) {
+        int chunk_max = max_array(c->count, c->values);
+        if (chunk_max > max) {
+            max = chunk_max;
+        }
+    }
+    return max;
+}
+
+int ulist_min(UList *list) {
+    int min = ulist_get_first(list);
+    for (Chunk *c = list->first; c; c = c->next) {
+        int chunk_min = min_array(c->count, c->values);
+        if (chunk_min < min) {
+            min = chunk_min;
+        }
+    }
+    return min;
+}
+
+int ulist_sum(UList *list) {
+    unsigned sum = 0;
+    for (Chunk *c = list->first; c; c = c->next) {
+        sum += (unsigned) sum_array(c->count, c->values);
+    }
+    return (int) sum;
+}
+
+long long ulist_sum64(UList *list) {
+    long long sum = 0;
+    for (Chunk *c = list->first; c; c = c->next) {
+        sum += sum64_array(c->count, c->values);
+    }
+    return sum;
+}
@@ -0,0 +1,323 @@
+#ifndef ULIST_H_
+#define ULIST_H_
+
+#include "ilist.h"
+
+/* Unrolled Integer Linked List */
+
+/* Values per chunk, so that a chunk takes 256 bytes. */
+#define ULIST_CHUNK 61
+
+typedef struct Chunk {
+    struct Chunk *next;
+    int count;
+    int values[ULIST_CHUNK];
+} Chunk;
+
+typedef struct {
+    Chunk *first;
+    Chunk *last;
+    int size;
+} UList;
+
+/* Reads the values of a list chunk by chunk (see ulist_blocks). */
+typedef struct {
+    Chunk *chunk;
+} UListBlocks;
+
+/* Returns true if this list contains some elements. */
+extern int ulist_is_empty(UList*);
+
+/* Returns true if this list contains no elements. */
+extern int ulist_is_not_empty(UList*);
+
+/* Returns a empty list. */
+extern UList* ulist_empty_list();
+
+/* Returns a list containing only the specified object. */
+extern UList* ulist_single_list_of(int);
+
+/* Returns a list containing an arbitrary number of elements. */
+extern UList* ulist_list_of(int, ...);
+
+/* Returns a sequential ordered UList from start (inclusive)
+    to end (inclusive) by an incremental step of 1 (or -1). */
+extern UList* ulist_range(int, int);
+
+/* Returns a sequential ordered UList from start (inclusive)
+    to end (inclusive) by a specified step. */
+extern UList* ulist_range_step(int, int, int);
+
+/* Returns a sequential ordered UList from start (inclusive)
+    to end (exclusive) by an incremental step of 1 (or -1). */
+extern UList* ulist_range_ex(int, int);
+
+/* Returns a sequential ordered UList from start (inclusive)
+    to end (exclusive) by a specified step. */
+extern UList* ulist_range_step_ex(int, int, int);
+
+/* Returns a list of n elements produced by iterative application
+    of a function to an initial element. */
+extern UList* ulist_generate_n(int, i_func, int);
+
+/* ulist_generate_n with a function that receives the context. */
+extern UList* ulist_generate_n_ctx(int, i_func_ctx, int, void*);
+
+/* Returns a list produced by iterative application of a function
+    to an initial element while the condition is satisfied. */
+extern UList* ulist_generate_while(int, i_func, i_func);
+
+/* ulist_generate_while with a function and a condition that receive the context. */
+extern UList* ulist_generate_while_ctx(int, i_func_ctx, i_func_ctx, void*);
+
+/* Returns a list consisting of n copies of the specified object. */
+extern UList* ulist_repeat(int, int);
+
+/* Delete the list. */
+extern void ulist_delete_list(UList**);
+
+/* Returns true if the arguments are equal to each other and false otherwise. */
+extern int ulist_equals(UList*, UList*);
+
+/* Returns a size of the list. */
+extern int ulist_get_size(UList*);
+
+/* [Mutator] Pushes an element onto the stack represented by this list.
+    (Inserts the specified element at the beginning of this list.) */
+extern UList* ulist_push(UList*, int);
+
+/* [Mutator] Appends the specified element to the end of this list. */
+extern UList* ulist_push_back(UList*, int);
+
+/* [Mutator] Inserts the specified element at the position of this list. */
+extern UList* ulist_insert(UList*, int, int);
+
+/* [Mutator] Pops an element from the stack represented by this list.
+    (Removes and returns the first element from this list.) */
+extern int ulist_pop(UList*);
+
+/* [Mutator] Removes and returns the last element from this list. */
+extern int ulist_pop_back(UList*);
+
+/* [Mutator] Removes the element at the specified position in this list. */
+extern UList* ulist_delete(UList*, int);
+
+/* [Mutator] Removes all occurrences of the specified element from this list. */
+extern UList* ulist_delete_item(UList*, int);
+
+/* [Mutator] Removes the first element from this list. */
+extern UList* ulist_drop(UList*);
+
+/* [Mutator] Removes the last element from this list. */
+extern UList* ulist_drop_back(UList*);
+
+/* [Mutator] Removes first n elements from this list. */
+extern UList* ulist_drop_n(UList*, int);
+
+/* [Mutator] Removes last n elements from this list. */
+extern UList* ulist_drop_back_n(UList*, int);
+
+/* [Mutator] Removes first elements from this list while the condition is satisfied. */
+extern UList* ulist_drop_while(UList*, i_func);
+
+/* [Mutator] ulist_drop_while with a predicate that receives the context. */
+extern UList* ulist_drop_while_ctx(UList*, i_func_ctx, void*);
+
+/* [Mutator] Removes last elements from this list while the condition is satisfied. */
+extern UList* ulist_drop_back_while(UList*, i_func);
+
+/* [Mutator] ulist_drop_back_while with a predicate that receives the context. */
+extern UList* ulist_drop_back_while_ctx(UList*, i_func_ctx, void*);
+
+/* [Mutator] Replaces the element at the specified position in this list
+    with the specified value. */
+extern UList* ulist_update(UList*, int, int);
+
+/* [Mutator] Returns sublist. */
+extern UList* ulist_sublist(UList*, int, int);
+
+/* Returns a list containing elements of the array. */
+extern UList* ulist_from_array(int, int*);
+
+/* Returns an array containing elements of the list. */
+extern int* ulist_to_array(UList*);
+
+/* Copies up to cap elements of the list into the buffer and returns their number. */
+extern int ulist_to_array_into(UList*, int*, int);
+
+/* [Mutator] Appends the specified count of elements from the array to the end
+    of this list, filling the last chunk before adding new ones. */
+extern UList* ulist_append_array(UList*, int, int*);
+
+/* Returns a reader of the values of the list that yields the chunks in place. */
+extern UListBlocks ulist_blocks(UList*);
+
+/* Stores into the pointer the values of the next chunk and returns their number,
+    or 0 after the last chunk. The values are not copied; the list must not
+    change while it is read. */
+extern int ulist_next_block(UListBlocks*, int**);
+
+/* Performs the given action for each element of the list. */
+extern void ulist_foreach(UList*, void (*op)(int));
+
+/* ulist_foreach with an action that receives the context. */
+extern void ulist_foreach_ctx(UList*, void (*op)(int, void*), void*);
+
+/* Print the list. */
+extern void ulist_print_list(UList*);
+
+/* Returns new list with elements in reversed order. */
+extern UList* ulist_reverse(UList*);
+
+/* Returns a first value of the list. */
+extern int ulist_get_first(UList*);
+
+/* Returns a last value of the list. */
+extern int ulist_get_last(UList*);
+
+/* Returns a value of the list at the specified position. */
+extern int ulist_get(UList*, int);
+
+/* Finds the first element of the list a predicate. */
+extern int ulist_find(UList*, i_func);
+
+/* Finds the first element of the list a negative predicate. */
+extern int ulist_find_not(UList*, i_func);
+
+/* Finds the first element of the list a predicate or returns default value. */
+extern int ulist_find_or(UList*, i_func, int);
+
+/* Finds the first element of the list a negative predicate or returns default value. */
+extern int ulist_find_not_or(UList*, i_func, int);
+
+/* ulist_find, ulist_find_not, ulist_find_or and ulist_find_not_or with a predicate that receives
+    the context. */
+extern int ulist_find_ctx(UList*, i_func_ctx, void*);
+extern int ulist_find_not_ctx(UList*, i_func_ctx, void*);
+extern int ulist_find_or_ctx(UList*, i_func_ctx, int, void*);
+extern int ulist_find_not_or_ctx(UList*, i_func_ctx, int, void*);
+
+/* Returns the index of the first occurrence of the specified element in this list,
+    or -1 if this list does not contain the element. */
+extern int ulist_index_of(UList*, int);
+
+/* Returns the index of the last occurrence of the specified element in this list,
+    or -1 if this list does not contain the element. */
+extern int ulist_last_index_of(UList*, int);
+
+/* Returns a copy of this. */
+extern UList* ulist_clone(UList*);
+
+/* Returns a list consisting of the results of applying the given function
+    to the elements of this list. */
+extern UList* ulist_map(UList*, i_func);
+
+/* ulist_map with a function that receives the context. */
+extern UList* ulist_map_ctx(UList*, i_func_ctx, void*);
+
+/* Returns a list consisting of the elements of this list that match the given predicate. */
+extern UList* ulist_filter(UList*, i_func);
+
+/* Returns a list consisting of the elements of this list that
+    match the negation given predicate. */
+extern UList* ulist_filter_not(UList*, i_func);
+
+/* ulist_filter and ulist_filter_not with a predicate that receives the context. */
+extern UList* ulist_filter_ctx(UList*, i_func_ctx, void*);
+extern UList* ulist_filter_not_ctx(UList*, i_func_ctx, void*);
+
+/* [Mutator] Appends all of the elements in the second collection to the end of first list. */
+extern UList* ulist_add_all(UList*, UList*);
+
+/* Returns true if the list contains the specified element. */
+extern int ulist_contains(UList*, int);
+
+/* Applies a binary operator to a start value and all elements of the list, going left to right. */
+extern int ulist_fold_left(int, UList*, i_bifunc);
+
+/* Applies a binary operator to all elements of the list, going left to right. */
+extern int ulist_reduce_left(UList*, i_bifunc);
+
+/* Applies a binary operator to all elements of the list and a start value, going right to left. */
+extern int ulist_fold_right(int, UList*, i_bifunc);
+
+/* Applies a binary operator to all elements of the list, going right to left. */
+extern int ulist_reduce_right(UList*, i_bifunc);
+
+/* The folds and reductions with an operator that receives the context. */
+extern int ulist_fold_left_ctx(int, UList*, i_bifunc_ctx, void*);
+extern int ulist_reduce_left_ctx(UList*, i_bifunc_ctx, void*);
+extern int ulist_fold_right_ctx(int, UList*, i_bifunc_ctx, void*);
+extern int ulist_reduce_right_ctx(UList*, i_bifunc_ctx, void*);
+
+/* Selects first n elements. */
+extern UList* ulist_take(UList*, int);
+
+/* Takes longest prefix of elements that satisfy a predicate. */
+extern UList* ulist_take_while(UList*, i_func);
+
+/* ulist_take_while with a predicate that receives the context. */
+extern UList* ulist_take_while_ctx(UList*, i_func_ctx, void*);
+
+/* Selects last n elements. */
+extern UList* ulist_take_right(UList*, int);
+
+/* Takes longest suffix of elements that satisfy a predicate. */
+extern UList* ulist_take_right_while(UList*, i_func);
+
+/* ulist_take_right_while with a predicate that receives the context. */
+extern UList* ulist_take_right_while_ctx(UList*, i_func_ctx, void*);
+
+/* Returns a list containing the elements greater than or equal to index from extending up
+    to index until of the list. */
+extern UList* ulist_slice(UList*, int, int);
+
+/* Tests whether a predicate holds for all elements of the list. */
+extern int ulist_forall(UList*, i_func);
+
+/* Tests whether a predicate holds for at least one element of the list. */
+extern int ulist_exists(UList*, i_func);
+
+/* Counts the number of elements in the list which satisfy a predicate. */
+extern int ulist_count(UList*, i_func);
+
+/* ulist_forall, ulist_exists and ulist_count with a predicate that receives the context. */
+extern int ulist_forall_ctx(UList*, i_func_ctx, void*);
+extern int ulist_exists_ctx(UList*, i_func_ctx, void*);
+extern int ulist_count_ctx(UList*, i_func_ctx, void*);
+
+/* Builds a new list from the list without any duplicate elements. */
+extern UList* ulist_unique(UList*);
+
+/* [Mutator] Returns a list consisting only of the distinct elements (according to ==). */
+extern UList* ulist_distinct(UList*);
+
+/* [Mutator] Swap values of two elements in the list. */
+extern UList* ulist_swap(UList*, int, int);
+
+/* Returns true iff the first list is a prefix of the second. */
+extern int ulist_is_prefix(UList*, UList*);
+
+/* Returns true iff the first list is a suffix of the second. */
+extern int ulist_is_suffix(UList*, UList*);
+
+/* Returns true iff the first list is a sublist of the second. */
+extern int ulist_is_sublist(UList*, UList*);
+
+/* Returns a new list containing elements that `interspersed`
+    by the element between the elements of the list. */
+extern UList* ulist_intersperse(UList*, int);
+
+/* Finds the largest element. */
+extern int ulist_max(UList*);
+
+/* Finds the smallest element. */
+extern int ulist_min(UList*);
+
+/* Sums up the elements of the list. */
+extern int ulist_sum(UList*);
+
+/* Sums up the elements of the list into a 64-bit accumulator. */
+extern long long ulist_sum64(UList*);
+
+#endif